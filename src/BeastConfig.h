@@ -157,6 +157,16 @@
 #define RIPPLE_SINGLE_IO_SERVICE_THREAD 0
 #endif
 
+/** Config: RIPPLE_FLAT_STATE_TABLES
+    When set, the state tables built while applying transactions keep
+    small sets of modifications in an inline sorted array instead of a
+    std::map. Clearing it restores the std::map tables, which is useful
+    for comparing the two with the FlatStateMap_manual benchmark.
+*/
+#ifndef RIPPLE_FLAT_STATE_TABLES
+#define RIPPLE_FLAT_STATE_TABLES 1
+#endif
+
 // Uses OpenSSL instead of alternatives
 #ifndef RIPPLE_USE_OPENSSL
 #define RIPPLE_USE_OPENSSL 1
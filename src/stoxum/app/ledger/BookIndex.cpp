@@ -0,0 +1,79 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2017 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+
+#include <BeastConfig.h>
+#include <stoxum/app/ledger/BookIndex.h>
+#include <stoxum/protocol/Indexes.h>
+#include <algorithm>
+
+namespace ripple {
+
+bool
+BookIndex::covers (uint256 const& key, uint256 const& last)
+{
+    auto const base = getQualityIndex (key);
+    return base != zero && last == getQualityNext (base);
+}
+
+boost::optional<uint256>
+BookIndex::succ (SHAMap const& map,
+    uint256 const& key, uint256 const& last) const
+{
+    auto const base = getQualityIndex (key);
+
+    Keys keys;
+    {
+        std::lock_guard<std::mutex> lock (mutex_);
+        auto const iter = books_.find (base);
+        if (iter != books_.end())
+            keys = iter->second;
+    }
+
+    if (! keys)
+    {
+        // A scan never returns the base itself
+        std::vector<uint256> v;
+        for (auto item = map.upper_bound (base);
+            item != map.end() && item->key() < last;
+                ++item)
+        {
+            v.push_back (item->key());
+        }
+        keys = std::make_shared<std::vector<uint256> const> (std::move (v));
+
+        std::lock_guard<std::mutex> lock (mutex_);
+        books_.emplace (base, keys);
+    }
+
+    auto const iter = std::upper_bound (keys->begin(), keys->end(), key);
+    if (iter == keys->end())
+        return boost::none;
+    return *iter;
+}
+
+std::size_t
+BookIndex::size() const
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+    return books_.size();
+}
+
+} // ripple
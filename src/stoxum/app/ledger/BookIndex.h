@@ -0,0 +1,80 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2017 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+
+#ifndef RIPPLE_APP_LEDGER_BOOKINDEX_H_INCLUDED
+#define RIPPLE_APP_LEDGER_BOOKINDEX_H_INCLUDED
+
+#include <stoxum/basics/base_uint.h>
+#include <stoxum/basics/UnorderedContainers.h>
+#include <stoxum/shamap/SHAMap.h>
+#include <boost/optional.hpp>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ripple {
+
+/** The quality directories of the order books in an immutable ledger.
+
+    Crossing offers, book_offers and path ranking find each quality of
+    a book by asking the ledger for the next key in the book's range,
+    which walks the state map every time. The first time a book is
+    scanned in a ledger, the keys of all its quality directories are
+    recorded, and later scans of the book are answered from them.
+
+    Views stacked on the ledger merge their own changes on top, so
+    the index stays correct for every view built on the ledger.
+*/
+class BookIndex
+{
+public:
+    BookIndex() = default;
+    BookIndex (BookIndex const&) = delete;
+    BookIndex& operator= (BookIndex const&) = delete;
+
+    /** Return `true` if [key, last) lies in the quality range of a book. */
+    static
+    bool
+    covers (uint256 const& key, uint256 const& last);
+
+    /** Return the first key after `key` and before `last`.
+
+        @param map The immutable state map of the ledger.
+        @note `covers (key, last)` must be `true`.
+    */
+    boost::optional<uint256>
+    succ (SHAMap const& map, uint256 const& key, uint256 const& last) const;
+
+    /** Number of books indexed. */
+    std::size_t
+    size() const;
+
+private:
+    using Keys = std::shared_ptr<std::vector<uint256> const>;
+
+    std::mutex mutable mutex_;
+    // Quality directory keys, in order, by book base
+    hash_map<uint256, Keys> mutable books_;
+};
+
+} // ripple
+
+#endif
@@ -22,6 +22,7 @@
 #include <stoxum/app/ledger/AcceptedLedger.h>
 #include <stoxum/app/ledger/InboundLedgers.h>
 #include <stoxum/app/ledger/LedgerMaster.h>
+#include <stoxum/app/ledger/LedgerSaveQueue.h>
 #include <stoxum/consensus/LedgerTiming.h>
 #include <stoxum/app/ledger/LedgerToJson.h>
 #include <stoxum/app/ledger/OrderBookDB.h>
@@ -422,6 +423,9 @@ boost::optional<uint256>
 Ledger::succ (uint256 const& key,
     boost::optional<uint256> const& last) const
 {
+    if (mImmutable && last && BookIndex::covers (key, *last))
+        return books_.succ (*stateMap_, key, *last);
+
     auto item = stateMap_->upper_bound(key);
     if (item == stateMap_->end())
         return boost::none;
@@ -801,7 +805,8 @@ void Ledger::updateSkipList ()
 static bool saveValidatedLedger (
     Application& app,
     std::shared_ptr<Ledger const> const& ledger,
-    bool current)
+    bool current,
+    bool isSynchronous)
 {
     auto j = app.journal ("Ledger");
     auto seq = ledger->info().seq;
@@ -812,18 +817,9 @@ static bool saveValidatedLedger (
         return true;
     }
 
-    // TODO(tom): Fix this hard-coded SQL!
     JLOG (j.trace())
         << "saveValidatedLedger "
         << (current ? "" : "fromAcquire ") << seq;
-    static boost::format deleteLedger (
-        "DELETE FROM Ledgers WHERE LedgerSeq = %u;");
-    static boost::format deleteTrans1 (
-        "DELETE FROM Transactions WHERE LedgerSeq = %u;");
-    static boost::format deleteTrans2 (
-        "DELETE FROM AccountTransactions WHERE LedgerSeq = %u;");
-    static boost::format deleteAcctTrans (
-        "DELETE FROM AccountTransactions WHERE TransID = '%s';");
 
     if (! ledger->info().accountHash.isNonZero ())
     {
@@ -872,141 +868,7 @@ static bool saveValidatedLedger (
         return false;
     }
 
-    {
-        auto db = app.getLedgerDB ().checkoutDb();
-        *db << boost::str (deleteLedger % seq);
-    }
-
-    {
-        auto db = app.getTxnDB ().checkoutDb ();
-
-        soci::transaction tr(*db);
-
-        *db << boost::str (deleteTrans1 % seq);
-        *db << boost::str (deleteTrans2 % seq);
-
-        std::string const ledgerSeq (std::to_string (seq));
-
-        for (auto const& vt : aLedger->getMap ())
-        {
-            uint256 transactionID = vt.second->getTransactionID ();
-
-            app.getMasterTransaction ().inLedger (
-                transactionID, seq);
-
-            std::string const txnId (to_string (transactionID));
-            std::string const txnSeq (std::to_string (vt.second->getTxnSeq ()));
-
-            *db << boost::str (deleteAcctTrans % transactionID);
-
-            auto const& accts = vt.second->getAffected ();
-
-            if (!accts.empty ())
-            {
-                std::string sql (
-                    "INSERT INTO AccountTransactions "
-                    "(TransID, Account, LedgerSeq, TxnSeq) VALUES ");
-
-                // Try to make an educated guess on how much space we'll need
-                // for our arguments. In argument order we have:
-                // 64 + 34 + 10 + 10 = 118 + 10 extra = 128 bytes
-                sql.reserve (sql.length () + (accts.size () * 128));
-
-                bool first = true;
-                for (auto const& account : accts)
-                {
-                    if (!first)
-                        sql += ", ('";
-                    else
-                    {
-                        sql += "('";
-                        first = false;
-                    }
-
-                    sql += txnId;
-                    sql += "','";
-                    sql += app.accountIDCache().toBase58(account);
-                    sql += "',";
-                    sql += ledgerSeq;
-                    sql += ",";
-                    sql += txnSeq;
-                    sql += ")";
-                }
-                sql += ";";
-                JLOG (j.trace()) << "ActTx: " << sql;
-                *db << sql;
-            }
-            else
-            {
-                JLOG (j.warn())
-                    << "Transaction in ledger " << seq
-                    << " affects no accounts";
-                JLOG (j.warn())
-                    << vt.second->getTxn()->getJson(0);
-            }
-
-            *db <<
-               (STTx::getMetaSQLInsertReplaceHeader () +
-                vt.second->getTxn ()->getMetaSQL (
-                    seq, vt.second->getEscMeta ()) + ";");
-        }
-
-        tr.commit ();
-    }
-
-    {
-        static std::string addLedger(
-            R"sql(INSERT OR REPLACE INTO Ledgers
-                (LedgerHash,LedgerSeq,PrevHash,TotalCoins,ClosingTime,PrevClosingTime,
-                CloseTimeRes,CloseFlags,AccountSetHash,TransSetHash)
-            VALUES
-                (:ledgerHash,:ledgerSeq,:prevHash,:totalCoins,:closingTime,:prevClosingTime,
-                :closeTimeRes,:closeFlags,:accountSetHash,:transSetHash);)sql");
-        static std::string updateVal(
-            R"sql(UPDATE Validations SET LedgerSeq = :ledgerSeq, InitialSeq = :initialSeq
-                WHERE LedgerHash = :ledgerHash;)sql");
-
-        auto db (app.getLedgerDB ().checkoutDb ());
-
-        soci::transaction tr(*db);
-
-        auto const hash = to_string (ledger->info().hash);
-        auto const parentHash = to_string (ledger->info().parentHash);
-        auto const drops = to_string (ledger->info().drops);
-        auto const closeTime =
-            ledger->info().closeTime.time_since_epoch().count();
-        auto const parentCloseTime =
-            ledger->info().parentCloseTime.time_since_epoch().count();
-        auto const closeTimeResolution =
-            ledger->info().closeTimeResolution.count();
-        auto const closeFlags = ledger->info().closeFlags;
-        auto const accountHash = to_string (ledger->info().accountHash);
-        auto const txHash = to_string (ledger->info().txHash);
-
-        *db << addLedger,
-            soci::use(hash),
-            soci::use(seq),
-            soci::use(parentHash),
-            soci::use(drops),
-            soci::use(closeTime),
-            soci::use(parentCloseTime),
-            soci::use(closeTimeResolution),
-            soci::use(closeFlags),
-            soci::use(accountHash),
-            soci::use(txHash);
-
-
-        *db << updateVal,
-            soci::use(seq),
-            soci::use(seq),
-            soci::use(hash);
-
-        tr.commit();
-    }
-
-    // Clients can now trust the database for
-    // information about this ledger sequence.
-    app.pendingSaves().finishWork(seq);
+    app.getLedgerSaveQueue().save ({ ledger, aLedger }, isSynchronous);
     return true;
 }
 
@@ -1055,14 +917,14 @@ bool pendSaveValidated (
     if (!isSynchronous &&
         app.getJobQueue().addJob (jobType, jobName,
         [&app, ledger, isCurrent] (Job&) {
-            saveValidatedLedger(app, ledger, isCurrent);
+            saveValidatedLedger(app, ledger, isCurrent, false);
         }))
     {
         return true;
     }
 
     // The JobQueue won't do the Job.  Do the save synchronously.
-    return saveValidatedLedger(app, ledger, isCurrent);
+    return saveValidatedLedger(app, ledger, isCurrent, true);
 }
 
 void
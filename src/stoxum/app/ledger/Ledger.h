@@ -20,6 +20,7 @@
 #ifndef RIPPLE_APP_LEDGER_LEDGER_H_INCLUDED
 #define RIPPLE_APP_LEDGER_LEDGER_H_INCLUDED
 
+#include <stoxum/app/ledger/BookIndex.h>
 #include <stoxum/ledger/TxMeta.h>
 #include <stoxum/ledger/View.h>
 #include <stoxum/ledger/CachedView.h>
@@ -325,6 +326,9 @@ private:
     std::shared_ptr<SHAMap> txMap_;
     std::shared_ptr<SHAMap> stateMap_;
 
+    // Answers scans of order books once the ledger is immutable
+    BookIndex books_;
+
     // Protects fee variables
     std::mutex mutable mutex_;
 
@@ -259,6 +259,17 @@ private:
     void getFetchPack(
         LedgerIndex missingIndex, InboundLedger::Reason reason);
 
+    /** Return the serialized fetch pack objects that take a peer holding
+        haveLedger to its parent wantLedger, from the cache if they were
+        precomputed. May throw if nodes are missing.
+    */
+    std::shared_ptr<std::string const> getFetchPackDelta (
+        std::shared_ptr<Ledger const> const& haveLedger,
+        std::shared_ptr<Ledger const> const& wantLedger);
+
+    void precomputeFetchPack (
+        std::shared_ptr<Ledger const> const& ledger);
+
     boost::optional<LedgerHash> getLedgerHashForHistory(
         LedgerIndex index, InboundLedger::Reason reason);
 
@@ -357,6 +368,13 @@ private:
 
     TaggedCache<uint256, Blob> fetch_packs_;
 
+    // Serialized fetch pack deltas for recently validated ledgers, keyed
+    // by the hash of the ledger the requesting peer already has.
+    TaggedCache<uint256, std::string> fetch_pack_deltas_;
+
+    // A precomputeFetchPack job is queued.
+    std::atomic <bool> fetchPackPrecomputing_ {false};
+
     std::uint32_t fetch_seq_ {0};
 
     // Try to keep a validator from switching from test to live network
@@ -365,6 +383,19 @@ private:
 
 };
 
+/** Serialize the fetch pack objects that take a peer holding haveLedger
+    to its parent wantLedger: the header of wantLedger, the state nodes
+    it has that haveLedger lacks, and its transaction nodes.
+
+    The result is a partial protocol::TMGetObjectByHash holding only the
+    objects, to be merged into a reply with MergeFromString. May throw if
+    nodes are missing.
+*/
+std::shared_ptr<std::string const>
+makeFetchPackDelta (
+    Ledger const& haveLedger,
+    Ledger const& wantLedger);
+
 } // ripple
 
 #endif
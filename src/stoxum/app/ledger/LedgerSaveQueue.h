@@ -0,0 +1,131 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2017 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_LEDGER_LEDGERSAVEQUEUE_H_INCLUDED
+#define RIPPLE_APP_LEDGER_LEDGERSAVEQUEUE_H_INCLUDED
+
+#include <stoxum/app/ledger/AcceptedLedger.h>
+#include <stoxum/app/ledger/Ledger.h>
+#include <stoxum/beast/insight/Collector.h>
+#include <stoxum/beast/utility/Journal.h>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ripple {
+
+class Application;
+
+/** Writes validated ledgers to the SQL databases.
+
+    Ledgers are queued once their transactions have been gathered,
+    and a single job on the job queue writes them out, several
+    ledgers per database transaction, with the statements prepared
+    once per batch. This keeps the databases from falling behind
+    while many historical ledgers are being acquired.
+
+    The queue is bounded. Callers that find it full write a batch
+    themselves, which holds up the job that is saving ledgers, and
+    LedgerMaster stops acquiring history while the queue is backed up.
+*/
+class LedgerSaveQueue
+{
+public:
+    struct Entry
+    {
+        std::shared_ptr<Ledger const> ledger;
+        AcceptedLedger::pointer accepted;
+    };
+
+    // Most ledgers written in one database transaction
+    static std::size_t constexpr batchSize = 16;
+
+    // Ledgers queued before callers must write
+    static std::size_t constexpr maxQueued = 64;
+
+    LedgerSaveQueue (Application& app,
+        beast::insight::Collector::ptr const& collector,
+            beast::Journal journal);
+
+    ~LedgerSaveQueue();
+
+    LedgerSaveQueue (LedgerSaveQueue const&) = delete;
+    LedgerSaveQueue& operator= (LedgerSaveQueue const&) = delete;
+
+    /** Write a ledger's rows.
+
+        The ledger must have been started with PendingSaves::startWork,
+        and it is finished once its rows are committed.
+
+        @param synchronous Write the ledger before returning.
+    */
+    void
+    save (Entry entry, bool synchronous);
+
+    /** Wait until every queued ledger is written. */
+    void
+    flush();
+
+    /** Ledgers waiting to be written. */
+    std::size_t
+    size() const;
+
+    /** Return `true` if history should not be acquired for now. */
+    bool
+    backlogged() const
+    {
+        return size() >= maxQueued / 2;
+    }
+
+private:
+    // Writes queued ledgers until none are left
+    void
+    run();
+
+    // Takes up to batchSize ledgers from the queue
+    std::vector<Entry>
+    take();
+
+    void
+    write (std::vector<Entry> const& batch);
+
+    Application& app_;
+    beast::Journal j_;
+
+    beast::insight::Event commitTime_;
+    beast::insight::Meter saved_;
+    beast::insight::Gauge queued_;
+
+    std::mutex mutable mutex_;
+    std::condition_variable cv_;
+    std::deque<Entry> queue_;
+    bool running_ = false;
+    // Batches taken but not yet written
+    std::size_t writers_ = 0;
+
+    // Serializes writers, so batches commit in order
+    std::mutex writeMutex_;
+};
+
+} // ripple
+
+#endif
@@ -0,0 +1,99 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2017 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_LEDGER_LEDGERVERIFIER_H_INCLUDED
+#define RIPPLE_APP_LEDGER_LEDGERVERIFIER_H_INCLUDED
+
+#include <stoxum/app/ledger/Ledger.h>
+#include <stoxum/json/json_value.h>
+#include <stoxum/beast/utility/Journal.h>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace ripple {
+
+class Application;
+
+/** Verifies a range of stored ledgers against the node store.
+
+    For each ledger, the header is loaded from the ledger database
+    and checked against its hash and the copy in the node store. Then
+    every state and transaction tree node that differs from the parent
+    ledger is fetched and its hash recomputed; the first ledger of the
+    range is walked in full. Optionally, each ledger is also rebuilt by
+    replaying its transactions, in metadata order, on top of the
+    stored parent, and the result must hash to the stored ledger.
+
+    Each ledger only depends on stored data, so ledgers are checked
+    concurrently on job queue threads, several ledgers ahead of the
+    one being reported. Results are reported in ledger order, which
+    is also where continuity of the parent hashes is checked.
+*/
+class LedgerVerifier
+{
+public:
+    struct Setup
+    {
+        LedgerIndex first = 0;
+        LedgerIndex last = 0;
+
+        // Rebuild each ledger from its parent
+        bool replay = false;
+
+        // Ledgers checked concurrently
+        std::size_t lookahead = 4;
+    };
+
+    LedgerVerifier (Application& app, beast::Journal j);
+
+    /** Check the ledgers in [setup.first, setup.last].
+
+        Blocks until the range is checked or the
+        application is stopping.
+
+        @return A report listing any failures.
+    */
+    Json::Value
+    run (Setup const& setup);
+
+    /** Check one ledger.
+
+        @param parent The stored parent ledger, if available.
+        @param full Walk every node of the ledger, instead of only
+                    the nodes that differ from `parent`.
+        @param replay Rebuild the ledger from `parent`.
+        @param nodes Incremented for each tree node checked.
+        @return A description of each problem found.
+    */
+    static
+    std::vector<std::string>
+    check (Application& app, Ledger const& ledger,
+        std::shared_ptr<Ledger const> const& parent,
+            bool full, bool replay, std::size_t& nodes,
+                beast::Journal j);
+
+private:
+    Application& app_;
+    beast::Journal j_;
+};
+
+} // ripple
+
+#endif
@@ -24,6 +24,7 @@
 #include <stoxum/ledger/CachedSLEs.h>
 #include <stoxum/ledger/OpenView.h>
 #include <stoxum/app/misc/CanonicalTXSet.h>
+#include <stoxum/app/tx/SpeculativeApply.h>
 #include <stoxum/basics/Log.h>
 #include <stoxum/basics/UnorderedContainers.h>
 #include <stoxum/core/Config.h>
@@ -198,7 +199,13 @@ private:
     apply_one (Application& app, OpenView& view,
         std::shared_ptr< STTx const> const& tx,
             bool retry, ApplyFlags flags,
-                bool shouldRecover, beast::Journal j);
+                bool shouldRecover, beast::Journal j,
+                    SpeculativeApply* speculative = nullptr,
+                        std::size_t index = 0);
+
+    static
+    std::size_t
+    parallelApply (Application& app);
 };
 
 //------------------------------------------------------------------------------
@@ -211,6 +218,7 @@ OpenLedger::apply (Application& app, OpenView& view,
             std::map<uint256, bool>& shouldRecover,
                 beast::Journal j)
 {
+    std::vector<std::shared_ptr<STTx const>> batch;
     for (auto iter = txs.begin();
         iter != txs.end(); ++iter)
     {
@@ -219,11 +227,38 @@ OpenLedger::apply (Application& app, OpenView& view,
             // Dereferencing the iterator can
             // throw since it may be transformed.
             auto const tx = *iter;
-            auto const txId = tx->getTransactionID();
-            if (check.txExists(txId))
-                continue;
+            if (! check.txExists(tx->getTransactionID()))
+                batch.push_back(tx);
+        }
+        catch(std::exception const&)
+        {
+            JLOG(j.error()) <<
+                "Caught exception";
+        }
+    }
+    boost::optional<SpeculativeApply> speculative;
+    if (auto const threads = parallelApply(app))
+    {
+        if (batch.size() > 1)
+        {
+            std::vector<SpeculativeApply::Entry> entries;
+            entries.reserve(batch.size());
+            for (auto const& tx : batch)
+                entries.push_back({ tx,
+                    flags | tapRETRY | tapPREFER_QUEUE });
+            speculative.emplace(app, view,
+                std::move(entries), threads, j);
+        }
+    }
+    for (std::size_t i = 0; i < batch.size(); ++i)
+    {
+        auto const& tx = batch[i];
+        try
+        {
             auto const result = apply_one(app, view,
-                tx, true, flags, shouldRecover[txId], j);
+                tx, true, flags,
+                    shouldRecover[tx->getTransactionID()], j,
+                        speculative.get_ptr(), i);
             if (result == Result::retry)
                 retries.insert(tx);
         }
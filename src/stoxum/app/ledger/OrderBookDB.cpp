@@ -25,6 +25,7 @@
 #include <stoxum/core/Config.h>
 #include <stoxum/core/JobQueue.h>
 #include <stoxum/protocol/Indexes.h>
+#include <algorithm>
 
 namespace ripple {
 
@@ -32,10 +33,38 @@ OrderBookDB::OrderBookDB (Application& app, Stoppable& parent)
     : Stoppable ("OrderBookDB", parent)
     , app_ (app)
     , mSeq (0)
+    , mScanning (false)
     , j_ (app.journal ("OrderBookDB"))
 {
 }
 
+// The book of a directory, if it is the root page of a quality
+static
+boost::optional<Book>
+getDirectoryBook (STObject const& dir, uint256 const& key)
+{
+    if (! dir.isFieldPresent (sfExchangeRate) ||
+        ! dir.isFieldPresent (sfRootIndex) ||
+        dir.getFieldH256 (sfRootIndex) != key)
+    {
+        return boost::none;
+    }
+
+    // Metadata leaves out the fields of a new entry that are zero
+    auto const get = [&dir](SField const& field)
+    {
+        return dir.isFieldPresent (field) ?
+            dir.getFieldH160 (field) : uint160 ();
+    };
+
+    Book book;
+    book.in.currency.copyFrom (get (sfTakerPaysCurrency));
+    book.in.account.copyFrom (get (sfTakerPaysIssuer));
+    book.out.account.copyFrom (get (sfTakerGetsIssuer));
+    book.out.currency.copyFrom (get (sfTakerGetsCurrency));
+    return book;
+}
+
 void OrderBookDB::invalidate ()
 {
     std::lock_guard <std::recursive_mutex> sl (mLock);
@@ -45,11 +74,20 @@ void OrderBookDB::invalidate ()
 void OrderBookDB::setup(
     std::shared_ptr<ReadView const> const& ledger)
 {
+    if (app_.config().PATH_SEARCH_MAX == 0)
+    {
+        // nothing to do
+        return;
+    }
+
     {
         std::lock_guard <std::recursive_mutex> sl (mLock);
         auto seq = ledger->info().seq;
 
-        // Do a full update every 256 ledgers
+        // Published ledgers keep the books current, so a scan is only
+        // needed when the ledgers jump too far to follow
+        if (mScanning)
+            return;
         if (mSeq != 0)
         {
             if (seq == mSeq)
@@ -64,13 +102,11 @@ void OrderBookDB::setup(
             << "Advancing from " << mSeq << " to " << seq;
 
         mSeq = seq;
+        mScanning = true;
+        mPending.clear();
     }
 
-    if (app_.config().PATH_SEARCH_MAX == 0)
-    {
-        // nothing to do
-    }
-    else if (app_.config().standalone())
+    if (app_.config().standalone())
         update(ledger);
     else
         app_.getJobQueue().addJob(
@@ -107,31 +143,24 @@ void OrderBookDB::update(
                     << "OrderBookDB::update exiting due to isStopping";
                 std::lock_guard <std::recursive_mutex> sl (mLock);
                 mSeq = 0;
+                mScanning = false;
+                mPending.clear();
                 return;
             }
 
-            if (sle->getType () == ltDIR_NODE &&
-                sle->isFieldPresent (sfExchangeRate) &&
-                sle->getFieldH256 (sfRootIndex) == sle->key())
+            if (sle->getType () != ltDIR_NODE)
+                continue;
+
+            if (auto const book = getDirectoryBook (*sle, sle->key()))
             {
-                Book book;
-                book.in.currency.copyFrom(sle->getFieldH160(
-                    sfTakerPaysCurrency));
-                book.in.account.copyFrom(sle->getFieldH160 (
-                    sfTakerPaysIssuer));
-                book.out.account.copyFrom(sle->getFieldH160(
-                    sfTakerGetsIssuer));
-                book.out.currency.copyFrom (sle->getFieldH160(
-                    sfTakerGetsCurrency));
-
-                uint256 index = getBookBase (book);
+                uint256 index = getBookBase (*book);
                 if (seen.insert (index).second)
                 {
-                    auto orderBook = std::make_shared<OrderBook> (index, book);
-                    sourceMap[book.in].push_back (orderBook);
-                    destMap[book.out].push_back (orderBook);
-                    if (isXRP(book.out))
-                        XRPBooks.insert(book.in);
+                    auto orderBook = std::make_shared<OrderBook> (index, *book);
+                    sourceMap[book->in].push_back (orderBook);
+                    destMap[book->out].push_back (orderBook);
+                    if (isXRP(book->out))
+                        XRPBooks.insert(book->in);
                     ++books;
                 }
             }
@@ -143,6 +172,8 @@ void OrderBookDB::update(
             << "OrderBookDB::update encountered a missing node";
         std::lock_guard <std::recursive_mutex> sl (mLock);
         mSeq = 0;
+        mScanning = false;
+        mPending.clear();
         return;
     }
 
@@ -154,45 +185,159 @@ void OrderBookDB::update(
         mXRPBooks.swap(XRPBooks);
         mSourceMap.swap(sourceMap);
         mDestMap.swap(destMap);
+        mBooks.swap(seen);
+
+        // Catch up with the ledgers published during the scan
+        auto const seq = ledger->info().seq;
+        for (auto const& delta : mPending)
+        {
+            if (mSeq != 0 && delta.seq > seq)
+            {
+                applyDelta (delta);
+                mSeq = std::max (mSeq, delta.seq);
+            }
+        }
+        mPending.clear();
+        mScanning = false;
     }
     app_.getLedgerMaster().newOrderBookDB();
 }
 
-void OrderBookDB::addOrderBook(Book const& book)
+void OrderBookDB::applyLedger (AcceptedLedger const& accepted)
 {
-    bool toXRP = isXRP (book.out);
-    std::lock_guard <std::recursive_mutex> sl (mLock);
+    if (app_.config().PATH_SEARCH_MAX == 0)
+        return;
 
-    if (toXRP)
-    {
-        // We don't want to search through all the to-STM or from-STM order
-        // books!
-        for (auto ob: mSourceMap[book.in])
-        {
-            if (isXRP (ob->getCurrencyOut ())) // also to STM
-                return;
-        }
-    }
-    else
+    auto const& ledger = accepted.getLedger();
+
+    // The root pages of quality directories created or deleted
+    hash_map<uint256, Book> touched;
+    for (auto const& item : accepted.getMap ())
     {
-        for (auto ob: mDestMap[book.out])
+        for (auto const& node : item.second->getMeta ()->getNodes ())
         {
-            if (ob->getCurrencyIn() == book.in.currency &&
-                ob->getIssuerIn() == book.in.account)
+            try
             {
-                return;
+                if (node.getFieldU16 (sfLedgerEntryType) != ltDIR_NODE)
+                    continue;
+
+                SField const* field = nullptr;
+                if (node.getFName () == sfCreatedNode)
+                    field = &sfNewFields;
+                else if (node.getFName () == sfDeletedNode)
+                    field = &sfFinalFields;
+                else
+                    continue;
+
+                auto data = dynamic_cast<const STObject*> (
+                    node.peekAtPField (*field));
+                if (! data)
+                    continue;
+
+                if (auto const book = getDirectoryBook (
+                    *data, node.getFieldH256 (sfLedgerIndex)))
+                {
+                    touched.emplace (getBookBase (*book), *book);
+                }
+            }
+            catch (std::exception const&)
+            {
+                JLOG (j_.info())
+                    << "Fields not found in OrderBookDB::applyLedger";
             }
         }
     }
+
+    // A book exists while any of its quality directories do
+    Delta delta;
+    delta.seq = ledger->info().seq;
+    for (auto const& book : touched)
+    {
+        if (ledger->succ (book.first, getQualityNext (book.first)))
+            delta.added.push_back (book.second);
+        else
+            delta.removed.push_back (book.second);
+    }
+
+    std::lock_guard <std::recursive_mutex> sl (mLock);
+
+    // Without books, the next scan finds them all
+    if (mSeq == 0)
+        return;
+
+    if (mScanning)
+    {
+        mPending.push_back (std::move (delta));
+        return;
+    }
+
+    if (delta.seq <= mSeq)
+        return;
+
+    applyDelta (delta);
+    mSeq = delta.seq;
+
+    JLOG (j_.trace())
+        << "OrderBookDB::applyLedger " << delta.seq << ": "
+        << delta.added.size() << " added, "
+        << delta.removed.size() << " removed";
+}
+
+void OrderBookDB::applyDelta (Delta const& delta)
+{
+    for (auto const& book : delta.added)
+        rawAddBook (book);
+    for (auto const& book : delta.removed)
+        rawRemoveBook (book);
+}
+
+void OrderBookDB::rawAddBook (Book const& book)
+{
     uint256 index = getBookBase(book);
+    if (! mBooks.insert (index).second)
+        return;
+
     auto orderBook = std::make_shared<OrderBook> (index, book);
 
     mSourceMap[book.in].push_back (orderBook);
     mDestMap[book.out].push_back (orderBook);
-    if (toXRP)
+    if (isXRP (book.out))
         mXRPBooks.insert(book.in);
 }
 
+void OrderBookDB::rawRemoveBook (Book const& book)
+{
+    uint256 index = getBookBase(book);
+    if (mBooks.erase (index) == 0)
+        return;
+
+    auto const remove = [&index](IssueToOrderBook& map, Issue const& issue)
+    {
+        auto it = map.find (issue);
+        if (it == map.end ())
+            return;
+        auto& list = it->second;
+        list.erase (std::remove_if (list.begin (), list.end (),
+            [&index](OrderBook::pointer const& ob)
+            {
+                return ob->getBookBase () == index;
+            }), list.end ());
+        if (list.empty ())
+            map.erase (it);
+    };
+
+    remove (mSourceMap, book.in);
+    remove (mDestMap, book.out);
+    if (isXRP (book.out))
+        mXRPBooks.erase (book.in);
+}
+
+void OrderBookDB::addOrderBook(Book const& book)
+{
+    std::lock_guard <std::recursive_mutex> sl (mLock);
+    rawAddBook (book);
+}
+
 // return list of all orderbooks that want this issuerID and currencyID
 OrderBook::List OrderBookDB::getBooksByTakerPays (Issue const& issue)
 {
@@ -245,7 +390,7 @@ BookListeners::pointer OrderBookDB::getBookListeners (Book const& book)
 // We need to determine which streams a given meta effects.
 void OrderBookDB::processTxn (
     std::shared_ptr<ReadView const> const& ledger,
-        const AcceptedLedgerTx& alTx, Json::Value const& jvObj)
+        const AcceptedLedgerTx& alTx, InfoSub::Message const& msg)
 {
     std::lock_guard <std::recursive_mutex> sl (mLock);
     if (alTx.getResult () == tesSUCCESS)
@@ -293,7 +438,7 @@ void OrderBookDB::processTxn (
                             auto listeners = getBookListeners(b);
                             if (listeners)
                             {
-                                listeners->publish(jvObj, havePublished);
+                                listeners->publish(msg, havePublished);
                             }
                         }
                     }
@@ -20,11 +20,13 @@
 #ifndef RIPPLE_APP_LEDGER_ORDERBOOKDB_H_INCLUDED
 #define RIPPLE_APP_LEDGER_ORDERBOOKDB_H_INCLUDED
 
+#include <stoxum/app/ledger/AcceptedLedger.h>
 #include <stoxum/app/ledger/AcceptedLedgerTx.h>
 #include <stoxum/app/ledger/BookListeners.h>
 #include <stoxum/app/main/Application.h>
 #include <stoxum/app/misc/OrderBook.h>
 #include <mutex>
+#include <vector>
 
 namespace ripple {
 
@@ -34,10 +36,21 @@ class OrderBookDB
 public:
     OrderBookDB (Application& app, Stoppable& parent);
 
+    /** Scan a ledger for every book, unless the books are current.
+
+        The books are only scanned for at startup, after invalidate,
+        or when the published ledgers jump too far to follow.
+    */
     void setup (std::shared_ptr<ReadView const> const& ledger);
     void update (std::shared_ptr<ReadView const> const& ledger);
     void invalidate ();
 
+    /** Add and remove books from the directories a ledger changed.
+
+        Called with each published ledger, in order.
+    */
+    void applyLedger (AcceptedLedger const& accepted);
+
     void addOrderBook(Book const&);
 
     /** @return a list of all orderbooks that want this issuerID and currencyID.
@@ -56,12 +69,22 @@ public:
     // see if this txn effects any orderbook
     void processTxn (
         std::shared_ptr<ReadView const> const& ledger,
-        const AcceptedLedgerTx& alTx, Json::Value const& jvObj);
+        const AcceptedLedgerTx& alTx, InfoSub::Message const& msg);
 
     using IssueToOrderBook = hash_map <Issue, OrderBook::List>;
 
 private:
+    // The books a ledger created or removed
+    struct Delta
+    {
+        std::uint32_t seq;
+        std::vector<Book> added;
+        std::vector<Book> removed;
+    };
+
     void rawAddBook(Book const&);
+    void rawRemoveBook(Book const&);
+    void applyDelta(Delta const&);
 
     Application& app_;
 
@@ -74,6 +97,9 @@ private:
     // does an order book to STM exist
     hash_set <Issue> mXRPBooks;
 
+    // the base of every book
+    hash_set <uint256> mBooks;
+
     std::recursive_mutex mLock;
 
     using BookToListenersMap = hash_map <Book, BookListeners::pointer>;
@@ -82,6 +108,10 @@ private:
 
     std::uint32_t mSeq;
 
+    // a scan is running, and the ledgers published meanwhile
+    bool mScanning;
+    std::vector<Delta> mPending;
+
     beast::Journal j_;
 };
 
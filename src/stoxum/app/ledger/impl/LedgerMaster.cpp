@@ -19,6 +19,7 @@
 
 #include <BeastConfig.h>
 #include <stoxum/app/ledger/LedgerMaster.h>
+#include <stoxum/app/ledger/LedgerSaveQueue.h>
 #include <stoxum/app/ledger/OpenLedger.h>
 #include <stoxum/app/ledger/OrderBookDB.h>
 #include <stoxum/app/ledger/PendingSaves.h>
@@ -76,6 +77,8 @@ LedgerMaster::LedgerMaster (Application& app, Stopwatch& stopwatch,
     , ledger_fetch_size_ (app_.config().getSize (siLedgerFetch))
     , fetch_packs_ ("FetchPack", 65536, 45, stopwatch,
         app_.journal("TaggedCache"))
+    , fetch_pack_deltas_ ("FetchPackDelta", 32, 120, stopwatch,
+        app_.journal("TaggedCache"))
 {
 }
 
@@ -225,6 +228,26 @@ LedgerMaster::setValidLedger(
             "One or more unsupported amendments activated: server blocked.";
         app_.getOPs().setAmendmentBlocked();
     }
+
+    // Peers syncing behind us will ask for the delta between this
+    // ledger and its parent, so build it once now rather than per request.
+    // Only one precompute is queued at a time, and none while fetch pack
+    // requests from peers are waiting, so this never delays serving them.
+    if (! standalone_ &&
+        app_.getJobQueue().getJobCount (jtPACK) == 0 &&
+        ! fetchPackPrecomputing_.exchange (true))
+    {
+        if (! app_.getJobQueue().addJob (
+            jtPACK, "precomputeFetchPack",
+            [this, l] (Job&)
+            {
+                precomputeFetchPack (l);
+                fetchPackPrecomputing_ = false;
+            }))
+        {
+            fetchPackPrecomputing_ = false;
+        }
+    }
 }
 
 void
@@ -1450,6 +1473,7 @@ LedgerMaster::sweep ()
 {
     mLedgerHistory.sweep ();
     fetch_packs_.sweep ();
+    fetch_pack_deltas_.sweep ();
 }
 
 float
@@ -1648,6 +1672,7 @@ void LedgerMaster::doAdvance (ScopedLockType& sl)
         {
             if (!standalone_ && !app_.getFeeTrack().isLoadedLocal() &&
                 (app_.getJobQueue().getJobCount(jtPUBOLDLEDGER) < 10) &&
+                ! app_.getLedgerSaveQueue().backlogged() &&
                 (mValidLedgerSeq == mPubLedgerSeq) &&
                 (getValidatedLedgerAge() < MAX_LEDGER_AGE_ACQUIRE))
             {
@@ -1832,18 +1857,6 @@ LedgerMaster::makeFetchPack (
     }
 
 
-    auto fpAppender = [](
-        protocol::TMGetObjectByHash* reply,
-        std::uint32_t ledgerSeq,
-        SHAMapHash const& hash,
-        const Blob& blob)
-    {
-        protocol::TMIndexedObject& newObj = * (reply->add_objects ());
-        newObj.set_ledgerseq (ledgerSeq);
-        newObj.set_hash (hash.as_uint256().begin (), 256 / 8);
-        newObj.set_data (&blob[0], blob.size ());
-    };
-
     try
     {
         protocol::TMGetObjectByHash reply;
@@ -1856,37 +1869,23 @@ LedgerMaster::makeFetchPack (
         reply.set_type (protocol::TMGetObjectByHash::otFETCH_PACK);
 
         // Building a fetch pack:
-        //  1. Add the header for the requested ledger.
-        //  2. Add the nodes for the AccountStateMap of that ledger.
-        //  3. If there are transactions, add the nodes for the
-        //     transactions of the ledger.
-        //  4. If the FetchPack now contains greater than or equal to
-        //     256 entries then stop.
-        //  5. If not very much time has elapsed, then loop back and repeat
+        //  1. Add the delta between the requested ledger and its
+        //     predecessor, from the cache if it was already built.
+        //  2. If the FetchPack now contains greater than or equal to
+        //     512 entries then stop.
+        //  3. If not very much time has elapsed, then loop back and repeat
         //     the same process adding the previous ledger to the FetchPack.
         do
         {
-            std::uint32_t lSeq = wantLedger->info().seq;
-
-            protocol::TMIndexedObject& newObj = *reply.add_objects ();
-            newObj.set_hash (
-                wantLedger->info().hash.data(), 256 / 8);
-            Serializer s (256);
-            s.add32 (HashPrefix::ledgerMaster);
-            addRaw(wantLedger->info(), s);
-            newObj.set_data (s.getDataPtr (), s.getLength ());
-            newObj.set_ledgerseq (lSeq);
-
-            wantLedger->stateMap().getFetchPack
-                (&haveLedger->stateMap(), true, 16384,
-                    std::bind (fpAppender, &reply, lSeq, std::placeholders::_1,
-                               std::placeholders::_2));
-
-            if (wantLedger->info().txHash.isNonZero ())
-                wantLedger->txMap().getFetchPack (
-                    nullptr, true, 512,
-                    std::bind (fpAppender, &reply, lSeq, std::placeholders::_1,
-                               std::placeholders::_2));
+            auto const delta = getFetchPackDelta (haveLedger, wantLedger);
+
+            if (! reply.MergeFromString (*delta))
+            {
+                JLOG(m_journal.warn())
+                    << "Unable to merge fetch pack delta for "
+                    << haveLedger->info().hash;
+                return;
+            }
 
             if (reply.objects ().size () >= 512)
                 break;
@@ -1909,10 +1908,99 @@ LedgerMaster::makeFetchPack (
     }
 }
 
+std::shared_ptr<std::string const>
+LedgerMaster::getFetchPackDelta (
+    std::shared_ptr<Ledger const> const& haveLedger,
+    std::shared_ptr<Ledger const> const& wantLedger)
+{
+    if (auto delta = fetch_pack_deltas_.fetch (haveLedger->info().hash))
+        return delta;
+
+    // Deltas for older ledgers are built on demand and not cached, so
+    // peers walking back through history can't fill the cache.
+    return makeFetchPackDelta (*haveLedger, *wantLedger);
+}
+
+void
+LedgerMaster::precomputeFetchPack (
+    std::shared_ptr<Ledger const> const& ledger)
+{
+    // A node that is not synced would be doing work no peer will ask for
+    if (app_.getFeeTrack ().isLoadedLocal () ||
+        (getValidatedLedgerAge() > 40s))
+        return;
+
+    auto const parent = getLedgerByHash (ledger->info().parentHash);
+
+    if (! parent)
+        return;
+
+    try
+    {
+        auto delta = std::const_pointer_cast<std::string> (
+            makeFetchPackDelta (*ledger, *parent));
+        JLOG(m_journal.debug())
+            << "Precomputed fetch pack for " << ledger->info().seq
+            << ": " << delta->size () << " bytes";
+        fetch_pack_deltas_.canonicalize (ledger->info().hash, delta);
+    }
+    catch (std::exception const&)
+    {
+        JLOG(m_journal.warn()) << "Exception precomputing fetch pack";
+    }
+}
+
 std::size_t
 LedgerMaster::getFetchPackCacheSize () const
 {
     return fetch_packs_.getCacheSize ();
 }
 
+//------------------------------------------------------------------------------
+
+std::shared_ptr<std::string const>
+makeFetchPackDelta (
+    Ledger const& haveLedger,
+    Ledger const& wantLedger)
+{
+    assert (haveLedger.info().parentHash == wantLedger.info().hash);
+
+    std::uint32_t const lSeq = wantLedger.info().seq;
+
+    // Only the repeated objects are filled in; the result is serialized
+    // without the required fields so it can be merged into any reply.
+    protocol::TMGetObjectByHash pack;
+
+    auto fpAppender = [&pack, lSeq](
+        SHAMapHash const& hash,
+        const Blob& blob)
+    {
+        protocol::TMIndexedObject& newObj = * (pack.add_objects ());
+        newObj.set_ledgerseq (lSeq);
+        newObj.set_hash (hash.as_uint256().begin (), 256 / 8);
+        newObj.set_data (&blob[0], blob.size ());
+    };
+
+    // The header of the ledger the peer wants
+    protocol::TMIndexedObject& newObj = *pack.add_objects ();
+    newObj.set_hash (
+        wantLedger.info().hash.data(), 256 / 8);
+    Serializer s (256);
+    s.add32 (HashPrefix::ledgerMaster);
+    addRaw(wantLedger.info(), s);
+    newObj.set_data (s.getDataPtr (), s.getLength ());
+    newObj.set_ledgerseq (lSeq);
+
+    // The state nodes it is missing, and all of its transaction nodes
+    wantLedger.stateMap().getFetchPack (
+        &haveLedger.stateMap(), true, 16384, fpAppender);
+
+    if (wantLedger.info().txHash.isNonZero ())
+        wantLedger.txMap().getFetchPack (nullptr, true, 512, fpAppender);
+
+    auto delta = std::make_shared<std::string> ();
+    pack.SerializePartialToString (delta.get ());
+    return delta;
+}
+
 } // ripple
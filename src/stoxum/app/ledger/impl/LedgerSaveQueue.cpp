@@ -0,0 +1,343 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2017 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <stoxum/app/ledger/LedgerSaveQueue.h>
+#include <stoxum/app/ledger/LedgerMaster.h>
+#include <stoxum/app/ledger/PendingSaves.h>
+#include <stoxum/app/ledger/TransactionMaster.h>
+#include <stoxum/app/main/Application.h>
+#include <stoxum/app/misc/AccountTxIndex.h>
+#include <stoxum/basics/Log.h>
+#include <stoxum/core/DatabaseCon.h>
+#include <stoxum/core/JobQueue.h>
+#include <stoxum/json/to_string.h>
+#include <stoxum/protocol/AccountID.h>
+#include <chrono>
+
+namespace ripple {
+
+// Most rows in one statement inserting transactions
+static std::size_t constexpr maxInsertRows = 128;
+
+LedgerSaveQueue::LedgerSaveQueue (Application& app,
+    beast::insight::Collector::ptr const& collector,
+        beast::Journal journal)
+    : app_ (app)
+    , j_ (journal)
+    , commitTime_ (collector->make_event ("ledger_save_commit"))
+    , saved_ (collector->make_meter ("ledger_save_ledgers"))
+    , queued_ (collector->make_gauge ("ledger_save_queued"))
+{
+}
+
+LedgerSaveQueue::~LedgerSaveQueue()
+{
+    flush();
+}
+
+std::size_t
+LedgerSaveQueue::size() const
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+    return queue_.size();
+}
+
+void
+LedgerSaveQueue::flush()
+{
+    std::unique_lock<std::mutex> lock (mutex_);
+    cv_.wait (lock, [this]
+        { return queue_.empty() && ! running_ && writers_ == 0; });
+}
+
+void
+LedgerSaveQueue::save (Entry entry, bool synchronous)
+{
+    if (synchronous)
+    {
+        write ({ std::move (entry) });
+        return;
+    }
+
+    bool start = false;
+    bool full = false;
+    {
+        std::lock_guard<std::mutex> lock (mutex_);
+        queue_.push_back (std::move (entry));
+        queued_ = queue_.size();
+        full = queue_.size() >= maxQueued;
+        if (! running_)
+            running_ = start = true;
+    }
+
+    if (start && ! app_.getJobQueue().addJob (jtSAVE_LEDGERS,
+            "LedgerSaveQueue::run", [this](Job&) { run(); }))
+        run();
+    else if (full)
+    {
+        // Help the writer catch up
+        auto const batch = take();
+        write (batch);
+        std::lock_guard<std::mutex> lock (mutex_);
+        writers_ -= 1;
+        cv_.notify_all();
+    }
+}
+
+std::vector<LedgerSaveQueue::Entry>
+LedgerSaveQueue::take()
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+    auto const n = std::min (queue_.size(), batchSize);
+    std::vector<Entry> batch (
+        std::make_move_iterator (queue_.begin()),
+        std::make_move_iterator (queue_.begin() + n));
+    queue_.erase (queue_.begin(), queue_.begin() + n);
+    queued_ = queue_.size();
+    writers_ += 1;
+    return batch;
+}
+
+void
+LedgerSaveQueue::run()
+{
+    for (;;)
+    {
+        auto const batch = take();
+        if (! batch.empty())
+            write (batch);
+
+        std::lock_guard<std::mutex> lock (mutex_);
+        writers_ -= 1;
+        if (batch.empty())
+        {
+            running_ = false;
+            cv_.notify_all();
+            return;
+        }
+    }
+}
+
+void
+LedgerSaveQueue::write (std::vector<Entry> const& batch)
+{
+    if (batch.empty())
+        return;
+
+    std::lock_guard<std::mutex> writeLock (writeMutex_);
+    auto const start = std::chrono::steady_clock::now();
+
+    auto& index = app_.getAccountTxIndex();
+    std::vector<AccountTxIndex::Posting> postings;
+
+    try
+    {
+        auto db = app_.getTxnDB ().checkoutDb ();
+
+        soci::transaction tr (*db);
+
+        std::uint32_t seq;
+        std::uint32_t txnSeq;
+        std::string txnId;
+        std::string account;
+
+        soci::statement deleteTrans = (db->prepare <<
+            "DELETE FROM Transactions WHERE LedgerSeq = :seq;",
+            soci::use (seq));
+        soci::statement deleteAcctTransBySeq = (db->prepare <<
+            "DELETE FROM AccountTransactions WHERE LedgerSeq = :seq;",
+            soci::use (seq));
+        soci::statement deleteAcctTrans = (db->prepare <<
+            "DELETE FROM AccountTransactions WHERE TransID = :id;",
+            soci::use (txnId));
+        soci::statement insertAcctTrans = (db->prepare <<
+            "INSERT INTO AccountTransactions "
+            "(TransID, Account, LedgerSeq, TxnSeq) "
+            "VALUES (:id, :account, :seq, :txnSeq);",
+            soci::use (txnId),
+            soci::use (account),
+            soci::use (seq),
+            soci::use (txnSeq));
+
+        for (auto const& entry : batch)
+        {
+            seq = entry.ledger->info().seq;
+
+            deleteTrans.execute (true);
+            if (! index.enabled ())
+                deleteAcctTransBySeq.execute (true);
+
+            // The raw transactions and metadata are rendered into the
+            // statement, so several rows are inserted per statement.
+            std::string sql;
+            std::size_t rows = 0;
+            auto const insertRows = [&]
+            {
+                if (rows == 0)
+                    return;
+                *db << (STTx::getMetaSQLInsertReplaceHeader () + sql + ";");
+                sql.clear();
+                rows = 0;
+            };
+
+            for (auto const& vt : entry.accepted->getMap ())
+            {
+                uint256 const transactionID =
+                    vt.second->getTransactionID ();
+
+                app_.getMasterTransaction ().inLedger (
+                    transactionID, seq);
+
+                txnId = to_string (transactionID);
+                txnSeq = vt.second->getTxnSeq ();
+
+                auto const& accts = vt.second->getAffected ();
+
+                if (index.enabled ())
+                {
+                    for (auto const& acct : accts)
+                        postings.push_back ({ acct, seq,
+                            txnSeq, transactionID });
+                }
+                else
+                {
+                    deleteAcctTrans.execute (true);
+                    for (auto const& acct : accts)
+                    {
+                        account = app_.accountIDCache().toBase58 (acct);
+                        insertAcctTrans.execute (true);
+                    }
+                }
+
+                if (accts.empty ())
+                {
+                    JLOG (j_.warn())
+                        << "Transaction in ledger " << seq
+                        << " affects no accounts";
+                    JLOG (j_.warn())
+                        << vt.second->getTxn()->getJson(0);
+                }
+
+                if (rows++ != 0)
+                    sql += ", ";
+                sql += vt.second->getTxn ()->getMetaSQL (
+                    seq, vt.second->getEscMeta ());
+                if (rows == maxInsertRows)
+                    insertRows();
+            }
+            insertRows();
+        }
+
+        tr.commit ();
+    }
+    catch (std::exception const& e)
+    {
+        JLOG (j_.fatal()) << "Unable to save ledgers: " << e.what();
+        for (auto const& entry : batch)
+        {
+            app_.getLedgerMaster().failedSave (
+                entry.ledger->info().seq, entry.ledger->info().hash);
+            app_.pendingSaves().finishWork (entry.ledger->info().seq);
+        }
+        return;
+    }
+
+    // Postings are only written once the transactions are stored
+    index.insert (postings);
+
+    {
+        auto db (app_.getLedgerDB ().checkoutDb ());
+
+        soci::transaction tr (*db);
+
+        std::uint32_t seq;
+        std::string hash;
+        std::string parentHash;
+        std::string drops;
+        NetClock::rep closeTime;
+        NetClock::rep parentCloseTime;
+        NetClock::rep closeTimeResolution;
+        int closeFlags;
+        std::string accountHash;
+        std::string txHash;
+
+        soci::statement deleteLedger = (db->prepare <<
+            "DELETE FROM Ledgers WHERE LedgerSeq = :ledgerSeq;",
+            soci::use (seq));
+        soci::statement addLedger = (db->prepare <<
+            R"sql(INSERT OR REPLACE INTO Ledgers
+                (LedgerHash,LedgerSeq,PrevHash,TotalCoins,ClosingTime,PrevClosingTime,
+                CloseTimeRes,CloseFlags,AccountSetHash,TransSetHash)
+            VALUES
+                (:ledgerHash,:ledgerSeq,:prevHash,:totalCoins,:closingTime,:prevClosingTime,
+                :closeTimeRes,:closeFlags,:accountSetHash,:transSetHash);)sql",
+            soci::use (hash),
+            soci::use (seq),
+            soci::use (parentHash),
+            soci::use (drops),
+            soci::use (closeTime),
+            soci::use (parentCloseTime),
+            soci::use (closeTimeResolution),
+            soci::use (closeFlags),
+            soci::use (accountHash),
+            soci::use (txHash));
+        soci::statement updateVal = (db->prepare <<
+            R"sql(UPDATE Validations SET LedgerSeq = :ledgerSeq, InitialSeq = :initialSeq
+                WHERE LedgerHash = :ledgerHash;)sql",
+            soci::use (seq),
+            soci::use (seq),
+            soci::use (hash));
+
+        for (auto const& entry : batch)
+        {
+            auto const& info = entry.ledger->info();
+            seq = info.seq;
+            hash = to_string (info.hash);
+            parentHash = to_string (info.parentHash);
+            drops = to_string (info.drops);
+            closeTime = info.closeTime.time_since_epoch().count();
+            parentCloseTime = info.parentCloseTime.time_since_epoch().count();
+            closeTimeResolution = info.closeTimeResolution.count();
+            closeFlags = info.closeFlags;
+            accountHash = to_string (info.accountHash);
+            txHash = to_string (info.txHash);
+
+            deleteLedger.execute (true);
+            addLedger.execute (true);
+            updateVal.execute (true);
+        }
+
+        tr.commit ();
+    }
+
+    // Clients can now trust the database for
+    // information about these ledger sequences.
+    for (auto const& entry : batch)
+        app_.pendingSaves().finishWork (entry.ledger->info().seq);
+
+    auto const elapsed = std::chrono::duration_cast<
+        std::chrono::milliseconds> (std::chrono::steady_clock::now() - start);
+    commitTime_.notify (elapsed);
+    saved_ += batch.size();
+    JLOG (j_.debug()) << "Saved " << batch.size() << " ledgers in " <<
+        elapsed.count() << "ms";
+}
+
+} // ripple
@@ -240,15 +240,28 @@ void fillJson (Object& json, LedgerFill const& fill)
         fillJsonState(json, fill);
 }
 
+template <class Object>
+void addJsonImpl (Object& json, LedgerFill const& fill)
+{
+    {
+        auto&& object = Json::addObject (json, jss::ledger);
+        fillJson (object, fill);
+    }
+
+    if ((fill.options & LedgerFill::dumpQueue) && !fill.txQueue.empty())
+        fillJsonQueue(json, fill);
+}
+
 } // namespace
 
 void addJson (Json::Value& json, LedgerFill const& fill)
 {
-    auto&& object = Json::addObject (json, jss::ledger);
-    fillJson (object, fill);
+    addJsonImpl (json, fill);
+}
 
-    if ((fill.options & LedgerFill::dumpQueue) && !fill.txQueue.empty())
-        fillJsonQueue(json, fill);
+void addJson (Json::Object& json, LedgerFill const& fill)
+{
+    addJsonImpl (json, fill);
 }
 
 Json::Value getJson (LedgerFill const& fill)
@@ -0,0 +1,327 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2017 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <stoxum/app/ledger/LedgerVerifier.h>
+#include <stoxum/app/main/Application.h>
+#include <stoxum/app/misc/HashRouter.h>
+#include <stoxum/app/tx/apply.h>
+#include <stoxum/basics/Log.h>
+#include <stoxum/core/JobQueue.h>
+#include <stoxum/ledger/OpenView.h>
+#include <stoxum/nodestore/Database.h>
+#include <stoxum/protocol/Feature.h>
+#include <stoxum/protocol/HashPrefix.h>
+#include <stoxum/protocol/JsonFields.h>
+#include <stoxum/shamap/SHAMapMissingNode.h>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+namespace ripple {
+
+namespace {
+
+// Recomputes the hash of every node of `map` not in `have`
+void
+checkNodes (SHAMap const& map, SHAMap const* have, char const* name,
+    std::vector<std::string>& errors, std::size_t& nodes)
+{
+    try
+    {
+        map.visitDifferences (have,
+            [&](SHAMapAbstractNode& node)
+            {
+                ++nodes;
+                auto const& hash = node.getNodeHash();
+                // An empty inner node has no hash
+                if (hash.isZero())
+                    return true;
+                Serializer s;
+                node.addRaw (s, snfPREFIX);
+                if (s.getSHA512Half() != hash.as_uint256())
+                    errors.push_back (std::string (name) +
+                        " node " + to_string (hash) + " is corrupt");
+                return true;
+            });
+    }
+    catch (SHAMapMissingNode const& mn)
+    {
+        std::stringstream ss;
+        ss << name << ": " << mn;
+        errors.push_back (ss.str());
+    }
+}
+
+void
+replayLedger (Application& app, Ledger const& ledger,
+    Ledger const& parent, std::vector<std::string>& errors,
+        beast::Journal j)
+{
+    auto const& info = ledger.info();
+    auto built = std::make_shared<Ledger> (parent, info.closeTime);
+    if (built->rules().enabled (featureSHAMapV2) &&
+            ! built->stateMap().is_v2())
+        built->make_v2();
+
+    std::map<std::uint32_t, std::shared_ptr<STTx const>> txs;
+    for (auto const& item : ledger.txs)
+    {
+        if (! item.second || ! item.second->isFieldPresent (
+                sfTransactionIndex))
+        {
+            errors.push_back ("transaction " +
+                to_string (item.first->getTransactionID()) +
+                    " has no metadata");
+            return;
+        }
+        txs.emplace ((*item.second)[sfTransactionIndex], item.first);
+    }
+
+    {
+        OpenView accum (&*built);
+        for (auto const& tx : txs)
+        {
+            // Also caches the result for later replays
+            auto const validity = checkValidity (app.getHashRouter(),
+                *tx.second, built->rules(), app.config()).first;
+            if (validity == Validity::SigBad)
+                errors.push_back ("transaction " +
+                    to_string (tx.second->getTransactionID()) +
+                        " has a bad signature");
+
+            if (applyTransaction (app, accum, *tx.second, false,
+                    tapNO_CHECK_SIGN, j) != ApplyResult::Success)
+                errors.push_back ("transaction " +
+                    to_string (tx.second->getTransactionID()) +
+                        " did not apply");
+        }
+        accum.apply (*built);
+    }
+
+    built->updateSkipList();
+    built->setAccepted (info.closeTime, info.closeTimeResolution,
+        (info.closeFlags & sLCF_NoConsensusTime) == 0, app.config());
+
+    if (built->info().hash == info.hash)
+        return;
+    if (built->info().accountHash != info.accountHash)
+        errors.push_back ("replay produced state " +
+            to_string (built->info().accountHash));
+    if (built->info().txHash != info.txHash)
+        errors.push_back ("replay produced transactions " +
+            to_string (built->info().txHash));
+    errors.push_back ("replay produced ledger " +
+        to_string (built->info().hash));
+}
+
+} // namespace
+
+LedgerVerifier::LedgerVerifier (Application& app, beast::Journal j)
+    : app_ (app)
+    , j_ (j)
+{
+}
+
+std::vector<std::string>
+LedgerVerifier::check (Application& app, Ledger const& ledger,
+    std::shared_ptr<Ledger const> const& parent,
+        bool full, bool replay, std::size_t& nodes,
+            beast::Journal j)
+{
+    std::vector<std::string> errors;
+    auto const& info = ledger.info();
+
+    Serializer header (128);
+    header.add32 (HashPrefix::ledgerMaster);
+    addRaw (info, header);
+    if (header.getSHA512Half() != info.hash)
+        errors.push_back ("header does not match its hash");
+
+    if (auto const obj = app.getNodeStore().fetch (info.hash, info.seq))
+    {
+        if (obj->getData() != header.peekData())
+            errors.push_back ("header differs from the node store");
+    }
+    else
+    {
+        errors.push_back ("header missing from the node store");
+    }
+
+    if (parent && parent->info().hash != info.parentHash)
+        errors.push_back ("parent ledger has the wrong hash");
+
+    checkNodes (ledger.stateMap(),
+        (full || ! parent) ? nullptr : &parent->stateMap(),
+            "state", errors, nodes);
+    checkNodes (ledger.txMap(), nullptr,
+        "transaction", errors, nodes);
+
+    if (replay)
+    {
+        if (! parent)
+        {
+            errors.push_back ("parent ledger missing, cannot replay");
+        }
+        else if (errors.empty())
+        {
+            try
+            {
+                replayLedger (app, ledger, *parent, errors, j);
+            }
+            catch (std::exception const& e)
+            {
+                errors.push_back (std::string ("replay failed: ") + e.what());
+            }
+        }
+    }
+
+    return errors;
+}
+
+Json::Value
+LedgerVerifier::run (Setup const& setup)
+{
+    struct Result
+    {
+        bool done = false;
+        bool found = false;
+        uint256 hash;
+        uint256 parentHash;
+        std::size_t nodes = 0;
+        std::vector<std::string> errors;
+    };
+
+    struct State
+    {
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::map<LedgerIndex, Result> results;
+    };
+
+    auto const state = std::make_shared<State>();
+    auto& app = app_;
+    auto const j = j_;
+    auto const first = setup.first;
+    auto const replay = setup.replay;
+
+    auto work = [&app, state, first, replay, j](LedgerIndex seq)
+    {
+        Result r;
+        try
+        {
+            if (auto const ledger = loadByIndex (seq, app))
+            {
+                r.found = true;
+                r.hash = ledger->info().hash;
+                r.parentHash = ledger->info().parentHash;
+                std::shared_ptr<Ledger const> parent;
+                if (seq > 1)
+                    parent = loadByHash (r.parentHash, app);
+                r.errors = check (app, *ledger, parent,
+                    seq == first, replay, r.nodes, j);
+            }
+        }
+        catch (std::exception const& e)
+        {
+            r.errors.push_back (std::string ("exception: ") + e.what());
+        }
+        r.done = true;
+
+        std::lock_guard<std::mutex> lock (state->mutex);
+        state->results[seq] = std::move (r);
+        state->cv.notify_all();
+    };
+
+    Json::Value ret (Json::objectValue);
+    ret[jss::min_ledger] = setup.first;
+    ret[jss::max_ledger] = setup.last;
+    ret[jss::replay] = setup.replay;
+    auto& failures = (ret[jss::failures] = Json::arrayValue);
+
+    auto const lookahead = std::max<std::size_t> (setup.lookahead, 1);
+    auto nextJob = setup.first;
+    auto const launch = [&](LedgerIndex limit)
+    {
+        for (; nextJob <= setup.last && nextJob < limit; ++nextJob)
+        {
+            auto const seq = nextJob;
+            if (! app.getJobQueue().addJob (jtVERIFY, "verifyLedger",
+                    [work, seq](Job&) { work (seq); }))
+                work (seq);
+        }
+    };
+
+    std::size_t checked = 0;
+    std::size_t nodes = 0;
+    boost::optional<uint256> prevHash;
+    for (auto seq = setup.first; seq <= setup.last; ++seq)
+    {
+        launch (seq + lookahead);
+
+        Result r;
+        {
+            std::unique_lock<std::mutex> lock (state->mutex);
+            using namespace std::chrono_literals;
+            while (! state->results[seq].done)
+            {
+                if (app.getJobQueue().isStopping())
+                    break;
+                state->cv.wait_for (lock, 1s);
+            }
+            r = std::move (state->results[seq]);
+            state->results.erase (seq);
+        }
+        if (! r.done)
+            break;
+
+        ++checked;
+        nodes += r.nodes;
+        if (! r.found)
+        {
+            r.errors.push_back ("ledger missing");
+            prevHash.reset();
+        }
+        else
+        {
+            if (prevHash && *prevHash != r.parentHash)
+                r.errors.push_back ("ledger does not follow the previous one");
+            prevHash = r.hash;
+        }
+
+        if (! r.errors.empty())
+        {
+            JLOG (j_.warn()) << "Ledger " << seq << " failed verification";
+            Json::Value failure (Json::objectValue);
+            failure[jss::ledger_index] = seq;
+            auto& errors = (failure[jss::errors] = Json::arrayValue);
+            for (auto const& e : r.errors)
+                errors.append (e);
+            failures.append (std::move (failure));
+        }
+    }
+
+    ret[jss::checked] = static_cast<Json::UInt> (checked);
+    ret[jss::nodes] = static_cast<Json::UInt> (nodes);
+    return ret;
+}
+
+} // ripple
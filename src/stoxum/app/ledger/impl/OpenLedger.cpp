@@ -186,21 +186,24 @@ auto
 OpenLedger::apply_one (Application& app, OpenView& view,
     std::shared_ptr<STTx const> const& tx,
         bool retry, ApplyFlags flags, bool shouldRecover,
-            beast::Journal j) -> Result
+            beast::Journal j, SpeculativeApply* speculative,
+                std::size_t index) -> Result
 {
     if (retry)
         flags = flags | tapRETRY;
-    auto const result = [&]
+    auto const serial = [&](OpenView& to)
     {
         auto const queueResult = app.getTxQ().apply(
-            app, view, tx, flags | tapPREFER_QUEUE, j);
+            app, to, tx, flags | tapPREFER_QUEUE, j);
         // If the transaction can't get into the queue for intrinsic
         // reasons, and it can still be recovered, try to put it
         // directly into the open ledger, else drop it.
         if (queueResult.first == telCAN_NOT_QUEUE && shouldRecover)
-            return ripple::apply(app, view, *tx, flags, j);
+            return ripple::apply(app, to, *tx, flags, j);
         return queueResult;
-    }();
+    };
+    auto const result = speculative ?
+        speculative->apply(index, view, serial) : serial(view);
     if (result.second ||
             result.first == terQUEUED)
         return Result::success;
@@ -211,6 +214,12 @@ OpenLedger::apply_one (Application& app, OpenView& view,
     return Result::retry;
 }
 
+std::size_t
+OpenLedger::parallelApply (Application& app)
+{
+    return app.config().PARALLEL_APPLY;
+}
+
 //------------------------------------------------------------------------------
 
 std::string
@@ -29,12 +29,14 @@
 #include <stoxum/app/ledger/LedgerToJson.h>
 #include <stoxum/app/ledger/OpenLedger.h>
 #include <stoxum/app/ledger/OrderBookDB.h>
+#include <stoxum/app/ledger/LedgerSaveQueue.h>
 #include <stoxum/app/ledger/PendingSaves.h>
 #include <stoxum/app/ledger/InboundTransactions.h>
 #include <stoxum/app/ledger/TransactionMaster.h>
 #include <stoxum/app/main/LoadManager.h>
 #include <stoxum/app/main/NodeIdentity.h>
 #include <stoxum/app/main/NodeStoreScheduler.h>
+#include <stoxum/app/misc/AccountTxIndex.h>
 #include <stoxum/app/misc/AmendmentTable.h>
 #include <stoxum/app/misc/HashRouter.h>
 #include <stoxum/app/misc/LoadFeeTrack.h>
@@ -55,6 +57,9 @@
 #include <stoxum/protocol/STParsedJSON.h>
 #include <stoxum/protocol/Protocol.h>
 #include <stoxum/resource/Fees.h>
+#include <stoxum/rpc/RPCAdmission.h>
+#include <stoxum/rpc/RPCResponseCache.h>
+#include <stoxum/rpc/RPCStats.h>
 #include <stoxum/beast/asio/io_latency_probe.h>
 #include <stoxum/beast/core/LexicalCast.h>
 #include <boost/asio/steady_timer.hpp>
@@ -336,6 +341,11 @@ public:
     // VFALCO TODO Make OrderBookDB abstract
     OrderBookDB m_orderBookDB;
     std::unique_ptr <PathRequests> m_pathRequests;
+    std::unique_ptr <AccountTxIndex> accountTxIndex_;
+    std::unique_ptr <LedgerSaveQueue> ledgerSaveQueue_;
+    std::unique_ptr <RPCStats> rpcStats_;
+    std::unique_ptr <RPCAdmission> rpcAdmission_;
+    std::unique_ptr <RPCResponseCache> rpcResponseCache_;
     std::unique_ptr <LedgerMaster> m_ledgerMaster;
     std::unique_ptr <InboundLedgers> m_inboundLedgers;
     std::unique_ptr <InboundTransactions> m_inboundTransactions;
@@ -444,6 +454,27 @@ public:
         , m_pathRequests (std::make_unique<PathRequests> (
             *this, logs_->journal("PathRequest"), m_collectorManager->collector ()))
 
+        , accountTxIndex_ (std::make_unique<AccountTxIndex> (
+            setup_AccountTxIndex (*config_), m_jobQueue.get(),
+                logs_->journal("AccountTxIndex")))
+
+        , ledgerSaveQueue_ (std::make_unique<LedgerSaveQueue> (
+            *this, m_collectorManager->collector (),
+                logs_->journal("LedgerSaveQueue")))
+
+        , rpcStats_ (std::make_unique<RPCStats> (
+            setup_RPCStats (*config_), m_collectorManager->group ("rpc_methods"),
+                logs_->journal("RPC")))
+
+        , rpcAdmission_ (std::make_unique<RPCAdmission> (
+            setup_RPCAdmission (*config_), *m_jobQueue,
+                m_collectorManager->collector (), logs_->journal("RPC")))
+
+        , rpcResponseCache_ (std::make_unique<RPCResponseCache> (
+            setup_RPCResponseCache (*config_), stopwatch(),
+                m_collectorManager->collector (),
+                    logs_->journal("TaggedCache")))
+
         , m_ledgerMaster (std::make_unique<LedgerMaster> (*this, stopwatch (),
             *m_jobQueue, m_collectorManager->collector (),
             logs_->journal("LedgerMaster")))
@@ -694,6 +725,11 @@ public:
         return *m_pathRequests;
     }
 
+    AccountTxIndex& getAccountTxIndex () override
+    {
+        return *accountTxIndex_;
+    }
+
     CachedSLEs&
     cachedSLEs() override
     {
@@ -755,6 +791,26 @@ public:
         return pendingSaves_;
     }
 
+    LedgerSaveQueue& getLedgerSaveQueue () override
+    {
+        return *ledgerSaveQueue_;
+    }
+
+    RPCStats& getRPCStats () override
+    {
+        return *rpcStats_;
+    }
+
+    RPCAdmission& getRPCAdmission () override
+    {
+        return *rpcAdmission_;
+    }
+
+    RPCResponseCache& getRPCResponseCache () override
+    {
+        return *rpcResponseCache_;
+    }
+
     AccountIDCache const&
     accountIDCache() const override
     {
@@ -1043,6 +1099,7 @@ public:
         if (sFamily_)
             sFamily_->treecache().sweep();
         cachedSLEs_.expire();
+        getRPCResponseCache().sweep();
 
         // Set timer to do another sweep later.
         setSweepTimer();
@@ -1142,6 +1199,17 @@ bool ApplicationImp::setup()
     if (!updateTables ())
         return false;
 
+    try
+    {
+        accountTxIndex_->open (mTxnDB.get());
+    }
+    catch (std::exception const& e)
+    {
+        JLOG(m_journal.fatal()) <<
+            "Unable to open the account_tx index: " << e.what();
+        return false;
+    }
+
     // Configure the amendments the server supports
     {
         Section supportedAmendments ("Supported Amendments");
@@ -48,7 +48,9 @@ class JobQueue;
 class InboundLedgers;
 class InboundTransactions;
 class AcceptedLedger;
+class AccountTxIndex;
 class LedgerMaster;
+class LedgerSaveQueue;
 class LoadManager;
 class ManifestCache;
 class NetworkOPs;
@@ -56,6 +58,9 @@ class OpenLedger;
 class OrderBookDB;
 class Overlay;
 class PathRequests;
+class RPCAdmission;
+class RPCResponseCache;
+class RPCStats;
 class PendingSaves;
 class PublicKey;
 class SecretKey;
@@ -163,8 +168,13 @@ public:
 
     virtual Resource::Manager&      getResourceManager () = 0;
     virtual PathRequests&           getPathRequests () = 0;
+    virtual AccountTxIndex&         getAccountTxIndex () = 0;
     virtual SHAMapStore&            getSHAMapStore () = 0;
     virtual PendingSaves&           pendingSaves() = 0;
+    virtual LedgerSaveQueue&        getLedgerSaveQueue () = 0;
+    virtual RPCStats&               getRPCStats () = 0;
+    virtual RPCAdmission&           getRPCAdmission () = 0;
+    virtual RPCResponseCache&       getRPCResponseCache () = 0;
     virtual AccountIDCache const&   accountIDCache() const = 0;
     virtual OpenLedger&             openLedger() = 0;
     virtual OpenLedger const&       openLedger() const = 0;
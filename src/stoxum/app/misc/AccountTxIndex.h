@@ -0,0 +1,202 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2017 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_APP_MISC_ACCOUNTTXINDEX_H_INCLUDED
+#define RIPPLE_APP_MISC_ACCOUNTTXINDEX_H_INCLUDED
+
+#include <stoxum/basics/base_uint.h>
+#include <stoxum/beast/utility/Journal.h>
+#include <stoxum/protocol/AccountID.h>
+#include <boost/filesystem/path.hpp>
+#include <boost/optional.hpp>
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace ripple {
+
+class Config;
+class DatabaseCon;
+class JobQueue;
+
+/** Maps accounts to the transactions that affected them.
+
+    This replaces the AccountTransactions table of the transaction
+    database. Each posting is a fixed size record holding the
+    account, the ledger sequence, the transaction's position in the
+    ledger and the transaction ID, encoded so that records sort by
+    account, then ledger, then position.
+
+    New postings go to an in-memory table and to a write-ahead log.
+    When the table is large enough it is written out as an immutable
+    sorted segment file, along with a sparse index of every block of
+    records, which is kept in memory. When there are too many
+    segments they are merged into one on the job queue, which also
+    drops the postings of deleted ledgers.
+
+    A posting does not prove that a transaction is still stored: a
+    ledger can be saved again, or deleted. Callers look transactions
+    up by ID and check the ledger sequence.
+*/
+class AccountTxIndex
+{
+public:
+    struct Setup
+    {
+        // Directory holding the index. Empty to disable it.
+        boost::filesystem::path path;
+
+        // Postings held in memory before a segment is written
+        std::size_t flushPostings = 65536;
+
+        // Segments allowed before they are merged
+        std::size_t maxSegments = 8;
+    };
+
+    struct Posting
+    {
+        AccountID account;
+        std::uint32_t ledgerSeq;
+        std::uint32_t txnSeq;
+        uint256 txID;
+    };
+
+    /** A position in an account's history, as (ledgerSeq, txnSeq). */
+    using Marker = std::pair<std::uint32_t, std::uint32_t>;
+
+    /** Create the index.
+
+        @param jobQueue Runs segment merges. If null, they
+                        are done by the thread that adds postings.
+    */
+    AccountTxIndex (Setup const& setup,
+        JobQueue* jobQueue, beast::Journal j);
+
+    ~AccountTxIndex();
+
+    AccountTxIndex (AccountTxIndex const&) = delete;
+    AccountTxIndex& operator= (AccountTxIndex const&) = delete;
+
+    bool
+    enabled() const
+    {
+        return ! setup_.path.empty();
+    }
+
+    /** Open the index, creating it if needed.
+
+        A new index is filled from the AccountTransactions table
+        of `txnDB`, when one is given.
+
+        @throws std::runtime_error if the files can't be used.
+    */
+    void
+    open (DatabaseCon* txnDB);
+
+    /** Add the postings of one ledger. */
+    void
+    insert (std::vector<Posting> const& postings);
+
+    /** Forget the postings of ledgers before `seq`. */
+    void
+    deleteBefore (std::uint32_t seq);
+
+    /** Visit an account's postings in [minLedger, maxLedger] in order.
+
+        @param start If set, the first posting visited is the first
+                     one at or past this position.
+        @param f Called as `bool f(Posting const&)` for each posting,
+                 returning `false` to stop.
+    */
+    void
+    forEach (AccountID const& account,
+        std::uint32_t minLedger, std::uint32_t maxLedger,
+            bool forward, boost::optional<Marker> const& start,
+                std::function<bool(Posting const&)> const& f) const;
+
+    /** Write out the in-memory postings and wait for merges. */
+    void
+    flush();
+
+    /** Number of segment files. */
+    std::size_t
+    segments() const;
+
+public:
+    static std::size_t constexpr keySize = 20 + 4 + 4;
+    static std::size_t constexpr recordSize = keySize + 32;
+
+    using Record = std::array<std::uint8_t, recordSize>;
+
+    class Segment;
+
+private:
+    // Moves the table out to be written. Returns
+    // true if the caller must call schedule().
+    bool
+    freeze();
+
+    void
+    schedule();
+
+    // Writes out frozen tables and merges segments
+    void
+    work();
+
+    void
+    writeManifest();
+
+    void
+    openLog (std::uint64_t id);
+
+    boost::filesystem::path
+    file (std::uint64_t id, char const* ext) const;
+
+    Setup const setup_;
+    JobQueue* jobQueue_;
+    beast::Journal j_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+
+    std::set<Record> table_;
+    // Tables being written out, newest last
+    std::vector<std::pair<std::uint64_t,
+        std::shared_ptr<std::vector<Record> const>>> frozen_;
+    std::vector<std::shared_ptr<Segment>> segments_;
+    std::ofstream log_;
+    std::uint64_t logId_ = 0;
+    std::uint64_t nextId_ = 1;
+    std::uint32_t floor_ = 0;
+    bool working_ = false;
+};
+
+AccountTxIndex::Setup
+setup_AccountTxIndex (Config const& config);
+
+} // ripple
+
+#endif
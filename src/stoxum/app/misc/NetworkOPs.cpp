@@ -40,6 +40,7 @@
 #include <stoxum/app/misc/ValidatorList.h>
 #include <stoxum/app/misc/impl/AccountTxPaging.h>
 #include <stoxum/app/tx/apply.h>
+#include <stoxum/app/tx/SpeculativeApply.h>
 #include <stoxum/basics/mulDiv.h>
 #include <stoxum/basics/UptimeTimer.h>
 #include <stoxum/core/ConfigSections.h>
@@ -408,6 +409,14 @@ public:
         std::int32_t maxLedger,  bool forward, Json::Value& token,
         int limit, bool bUnlimited) override;
 
+    void
+    forEachTxAccount (
+        AccountID const& account, std::int32_t minLedger,
+        std::int32_t maxLedger,  bool forward, Json::Value& token,
+        int limit, bool bUnlimited,
+        std::function<void (std::uint32_t,
+            Blob const&, Blob const&)> const& f) override;
+
     //
     // Monitoring: publisher side.
     //
@@ -1023,16 +1032,41 @@ void NetworkOPsImp::apply (std::unique_lock<std::mutex>& batchLock)
             app_.openLedger().modify(
                 [&](OpenView& view, beast::Journal j)
             {
-                for (TransactionStatus& e : transactions)
+                auto const flagsFor = [](TransactionStatus const& e)
                 {
                     // we check before addingto the batch
                     ApplyFlags flags = tapNO_CHECK_SIGN;
                     if (e.admin)
                         flags = flags | tapUNLIMITED;
+                    return flags;
+                };
+
+                boost::optional<SpeculativeApply> speculative;
+                if (app_.config().PARALLEL_APPLY &&
+                    transactions.size() > 1)
+                {
+                    std::vector<SpeculativeApply::Entry> entries;
+                    entries.reserve (transactions.size());
+                    for (auto const& e : transactions)
+                        entries.push_back ({
+                            e.transaction->getSTransaction(),
+                                flagsFor (e) });
+                    speculative.emplace (app_, view, std::move(entries),
+                        app_.config().PARALLEL_APPLY, j);
+                }
 
-                    auto const result = app_.getTxQ().apply(
-                        app_, view, e.transaction->getSTransaction(),
-                        flags, j);
+                for (std::size_t i = 0; i < transactions.size(); ++i)
+                {
+                    TransactionStatus& e = transactions[i];
+                    auto const serial = [&](OpenView& to)
+                    {
+                        return app_.getTxQ().apply(app_, to,
+                            e.transaction->getSTransaction(),
+                                flagsFor (e), j);
+                    };
+                    auto const result = speculative ?
+                        speculative->apply (i, view, serial) :
+                            serial (view);
                     e.result = result.first;
                     e.applied = result.second;
                     changed = changed || result.second;
@@ -1563,12 +1597,14 @@ void NetworkOPsImp::pubManifest (Manifest const& mo)
         jvObj [jss::signature]        = strHex (mo.getSignature ());
         jvObj [jss::master_signature] = strHex (mo.getMasterSignature ());
 
+        InfoSub::Message const msg (jvObj);
+
         for (auto i = mStreamMaps[sManifests].begin ();
             i != mStreamMaps[sManifests].end (); )
         {
             if (auto p = i->second.lock())
             {
-                p->send (jvObj, true);
+                p->send (msg, true);
                 ++i;
             }
             else
@@ -1662,6 +1698,8 @@ void NetworkOPsImp::pubServer ()
 
         mLastFeeSummary = f;
 
+        InfoSub::Message const msg (jvObj);
+
         for (auto i = mStreamMaps[sServer].begin ();
             i != mStreamMaps[sServer].end (); )
         {
@@ -1672,7 +1710,7 @@ void NetworkOPsImp::pubServer ()
             //             sending of JSON data.
             if (p)
             {
-                p->send (jvObj, true);
+                p->send (msg, true);
                 ++i;
             }
             else
@@ -1728,12 +1766,14 @@ void NetworkOPsImp::pubValidation (STValidation::ref val)
         if (auto const reserveInc = (*val)[~sfReserveIncrement])
             jvObj [jss::reserve_inc] = *reserveInc;
 
+        InfoSub::Message const msg (jvObj);
+
         for (auto i = mStreamMaps[sValidations].begin ();
             i != mStreamMaps[sValidations].end (); )
         {
             if (auto p = i->second.lock())
             {
-                p->send (jvObj, true);
+                p->send (msg, true);
                 ++i;
             }
             else
@@ -1755,6 +1795,8 @@ void NetworkOPsImp::pubPeerStatus (
 
         jvObj [jss::type]                  = "peerStatusChange";
 
+        InfoSub::Message const msg (jvObj);
+
         for (auto i = mStreamMaps[sPeerStatus].begin ();
             i != mStreamMaps[sPeerStatus].end (); )
         {
@@ -1762,7 +1804,7 @@ void NetworkOPsImp::pubPeerStatus (
 
             if (p)
             {
-                p->send (jvObj, true);
+                p->send (msg, true);
                 ++i;
             }
             else
@@ -1801,36 +1843,36 @@ void NetworkOPsImp::setMode (OperatingMode om)
 }
 
 
-std::string
-NetworkOPsImp::transactionsSQL (
-    std::string selection, AccountID const& account,
-    std::int32_t minLedger, std::int32_t maxLedger, bool descending,
-    std::uint32_t offset, int limit,
-    bool binary, bool count, bool bUnlimited)
+// The number of transactions returned by one account history request
+static
+std::uint32_t
+accountTxsLimit (int limit, bool binary, bool bUnlimited)
 {
     std::uint32_t NONBINARY_PAGE_LENGTH = 200;
     std::uint32_t BINARY_PAGE_LENGTH = 500;
 
-    std::uint32_t numberOfResults;
+    if (limit < 0)
+        return binary ? BINARY_PAGE_LENGTH : NONBINARY_PAGE_LENGTH;
 
-    if (count)
-    {
-        numberOfResults = 1000000000;
-    }
-    else if (limit < 0)
-    {
-        numberOfResults = binary ? BINARY_PAGE_LENGTH : NONBINARY_PAGE_LENGTH;
-    }
-    else if (!bUnlimited)
+    if (!bUnlimited)
     {
-        numberOfResults = std::min (
+        return std::min (
             binary ? BINARY_PAGE_LENGTH : NONBINARY_PAGE_LENGTH,
             static_cast<std::uint32_t> (limit));
     }
-    else
-    {
-        numberOfResults = limit;
-    }
+
+    return limit;
+}
+
+std::string
+NetworkOPsImp::transactionsSQL (
+    std::string selection, AccountID const& account,
+    std::int32_t minLedger, std::int32_t maxLedger, bool descending,
+    std::uint32_t offset, int limit,
+    bool binary, bool count, bool bUnlimited)
+{
+    std::uint32_t const numberOfResults = count ? 1000000000 :
+        accountTxsLimit (limit, binary, bUnlimited);
 
     std::string maxClause = "";
     std::string minClause = "";
@@ -1893,6 +1935,24 @@ NetworkOPs::AccountTxs NetworkOPsImp::getAccountTxs (
     // can be called with no locks
     AccountTxs ret;
 
+    if (app_.getAccountTxIndex().enabled())
+    {
+        Application& app = app_;
+        accountTxIndexRange (app_.getTxnDB (), app_.getAccountTxIndex(),
+            std::bind (saveLedgerAsync, std::ref (app_),
+                std::placeholders::_1),
+            [&ret, &app](std::uint32_t ledgerIndex,
+                std::string const& status, Blob const& rawTxn,
+                    Blob const& rawMeta)
+            {
+                convertBlobsToTxResult (
+                    ret, ledgerIndex, status, rawTxn, rawMeta, app);
+            },
+            account, minLedger, maxLedger, ! descending, offset,
+                accountTxsLimit (limit, false, bUnlimited));
+        return ret;
+    }
+
     std::string sql = transactionsSQL (
         "AccountTransactions.LedgerSeq,Status,RawTxn,TxnMeta", account,
         minLedger, maxLedger, descending, offset, limit, false, false,
@@ -1961,6 +2021,23 @@ std::vector<NetworkOPsImp::txnMetaLedgerType> NetworkOPsImp::getAccountTxsB (
     // can be called with no locks
     std::vector<txnMetaLedgerType> ret;
 
+    if (app_.getAccountTxIndex().enabled())
+    {
+        accountTxIndexRange (app_.getTxnDB (), app_.getAccountTxIndex(),
+            std::bind (saveLedgerAsync, std::ref (app_),
+                std::placeholders::_1),
+            [&ret](std::uint32_t ledgerIndex,
+                std::string const&, Blob const& rawTxn,
+                    Blob const& rawMeta)
+            {
+                ret.emplace_back (
+                    strHex (rawTxn), strHex (rawMeta), ledgerIndex);
+            },
+            account, minLedger, maxLedger, ! descending, offset,
+                accountTxsLimit (limit, true, bUnlimited));
+        return ret;
+    }
+
     std::string sql = transactionsSQL (
         "AccountTransactions.LedgerSeq,Status,RawTxn,TxnMeta", account,
         minLedger, maxLedger, descending, offset, limit, true/*binary*/, false,
@@ -2023,11 +2100,18 @@ NetworkOPsImp::getTxsAccount (
             ret, ledger_index, status, rawTxn, rawMeta, app);
     };
 
-    accountTxPage(app_.getTxnDB (), app_.accountIDCache(),
-        std::bind(saveLedgerAsync, std::ref(app_),
-            std::placeholders::_1), bound, account, minLedger,
-                maxLedger, forward, token, limit, bUnlimited,
-                    page_length);
+    if (app_.getAccountTxIndex().enabled())
+        accountTxIndexPage(app_.getTxnDB (), app_.getAccountTxIndex(),
+            std::bind(saveLedgerAsync, std::ref(app_),
+                std::placeholders::_1), bound, account, minLedger,
+                    maxLedger, forward, token, limit, bUnlimited,
+                        page_length);
+    else
+        accountTxPage(app_.getTxnDB (), app_.accountIDCache(),
+            std::bind(saveLedgerAsync, std::ref(app_),
+                std::placeholders::_1), bound, account, minLedger,
+                    maxLedger, forward, token, limit, bUnlimited,
+                        page_length);
 
     return ret;
 }
@@ -2038,25 +2122,51 @@ NetworkOPsImp::getTxsAccountB (
     std::int32_t maxLedger,  bool forward, Json::Value& token,
     int limit, bool bUnlimited)
 {
-    static const std::uint32_t page_length (500);
-
     MetaTxsList ret;
 
-    auto bound = [&ret](
+    forEachTxAccount (account, minLedger, maxLedger, forward, token,
+        limit, bUnlimited,
+        [&ret](
+            std::uint32_t ledgerIndex,
+            Blob const& rawTxn,
+            Blob const& rawMeta)
+        {
+            ret.emplace_back (strHex(rawTxn), strHex (rawMeta), ledgerIndex);
+        });
+    return ret;
+}
+
+void
+NetworkOPsImp::forEachTxAccount (
+    AccountID const& account, std::int32_t minLedger,
+    std::int32_t maxLedger,  bool forward, Json::Value& token,
+    int limit, bool bUnlimited,
+    std::function<void (std::uint32_t,
+        Blob const&, Blob const&)> const& f)
+{
+    static const std::uint32_t page_length (500);
+
+    auto bound = [&f](
         std::uint32_t ledgerIndex,
         std::string const& status,
         Blob const& rawTxn,
         Blob const& rawMeta)
     {
-        ret.emplace_back (strHex(rawTxn), strHex (rawMeta), ledgerIndex);
+        f (ledgerIndex, rawTxn, rawMeta);
     };
 
-    accountTxPage(app_.getTxnDB (), app_.accountIDCache(),
-        std::bind(saveLedgerAsync, std::ref(app_),
-            std::placeholders::_1), bound, account, minLedger,
-                maxLedger, forward, token, limit, bUnlimited,
-                    page_length);
-    return ret;
+    if (app_.getAccountTxIndex().enabled())
+        accountTxIndexPage(app_.getTxnDB (), app_.getAccountTxIndex(),
+            std::bind(saveLedgerAsync, std::ref(app_),
+                std::placeholders::_1), bound, account, minLedger,
+                    maxLedger, forward, token, limit, bUnlimited,
+                        page_length);
+    else
+        accountTxPage(app_.getTxnDB (), app_.accountIDCache(),
+            std::bind(saveLedgerAsync, std::ref(app_),
+                std::placeholders::_1), bound, account, minLedger,
+                    maxLedger, forward, token, limit, bUnlimited,
+                        page_length);
 }
 
 bool NetworkOPsImp::recvValidation (
@@ -2351,6 +2461,8 @@ void NetworkOPsImp::pubProposedTransaction (
     {
         ScopedLockType sl (mSubLock);
 
+        InfoSub::Message const msg (jvObj);
+
         auto it = mStreamMaps[sRTTransactions].begin ();
         while (it != mStreamMaps[sRTTransactions].end ())
         {
@@ -2358,7 +2470,7 @@ void NetworkOPsImp::pubProposedTransaction (
 
             if (p)
             {
-                p->send (jvObj, true);
+                p->send (msg, true);
                 ++it;
             }
             else
@@ -2389,6 +2501,8 @@ void NetworkOPsImp::pubLedger (
             lpAccepted->info().hash, alpAccepted);
     }
 
+    app_.getOrderBookDB().applyLedger (*alpAccepted);
+
     {
         ScopedLockType sl (mSubLock);
 
@@ -2416,13 +2530,15 @@ void NetworkOPsImp::pubLedger (
                         = app_.getLedgerMaster ().getCompleteLedgers ();
             }
 
+            InfoSub::Message const msg (jvObj);
+
             auto it = mStreamMaps[sLedger].begin ();
             while (it != mStreamMaps[sLedger].end ())
             {
                 InfoSub::pointer p = it->second.lock ();
                 if (p)
                 {
-                    p->send (jvObj, true);
+                    p->send (msg, true);
                     ++it;
                 }
                 else
@@ -2515,6 +2631,7 @@ void NetworkOPsImp::pubValidatedTransaction (
     Json::Value jvObj = transJson (
         *alTx.getTxn (), alTx.getResult (), true, alAccepted);
     jvObj[jss::meta] = alTx.getMeta ()->getJson (0);
+    InfoSub::Message const msg (jvObj);
 
     {
         ScopedLockType sl (mSubLock);
@@ -2526,7 +2643,7 @@ void NetworkOPsImp::pubValidatedTransaction (
 
             if (p)
             {
-                p->send (jvObj, true);
+                p->send (msg, true);
                 ++it;
             }
             else
@@ -2541,14 +2658,14 @@ void NetworkOPsImp::pubValidatedTransaction (
 
             if (p)
             {
-                p->send (jvObj, true);
+                p->send (msg, true);
                 ++it;
             }
             else
                 it = mStreamMaps[sRTTransactions].erase (it);
         }
     }
-    app_.getOrderBookDB ().processTxn (alAccepted, alTx, jvObj);
+    app_.getOrderBookDB ().processTxn (alAccepted, alTx, msg);
     pubAccountTransaction (alAccepted, alTx, true);
 }
 
@@ -2628,8 +2745,10 @@ void NetworkOPsImp::pubAccountTransaction (
         if (alTx.isApplied ())
             jvObj[jss::meta] = alTx.getMeta ()->getJson (0);
 
+        InfoSub::Message const msg (jvObj);
+
         for (InfoSub::ref isrListener : notify)
-            isrListener->send (jvObj, true);
+            isrListener->send (msg, true);
     }
 }
 
@@ -223,6 +223,15 @@ public:
         std::int32_t minLedger, std::int32_t maxLedger,  bool forward,
         Json::Value& token, int limit, bool bUnlimited) = 0;
 
+    /** Like getTxsAccountB, passing each transaction's ledger
+        sequence, raw transaction and raw metadata to `f`.
+    */
+    virtual void forEachTxAccount (AccountID const& account,
+        std::int32_t minLedger, std::int32_t maxLedger,  bool forward,
+        Json::Value& token, int limit, bool bUnlimited,
+        std::function<void (std::uint32_t,
+            Blob const&, Blob const&)> const& f) = 0;
+
     //--------------------------------------------------------------------------
     //
     // Monitoring: publisher side
@@ -20,6 +20,7 @@
 #include <BeastConfig.h>
 
 #include <stoxum/app/ledger/TransactionMaster.h>
+#include <stoxum/app/misc/AccountTxIndex.h>
 #include <stoxum/app/misc/NetworkOPs.h>
 #include <stoxum/app/misc/SHAMapStoreImp.h>
 #include <stoxum/beast/core/CurrentThreadName.h>
@@ -768,6 +769,7 @@ SHAMapStoreImp::clearPrior (LedgerIndex lastRotated)
     clearSql (*transactionDb_, lastRotated,
         "SELECT MIN(LedgerSeq) FROM AccountTransactions;",
         "DELETE FROM AccountTransactions WHERE LedgerSeq < %u;");
+    app_.getAccountTxIndex().deleteBefore (lastRotated);
     if (health())
         return;
 }
@@ -126,6 +126,19 @@ public:
         std::shared_ptr<STTx const> const& tx,
             ApplyFlags flags, beast::Journal j);
 
+    /**
+        Returns `true` if `apply` would put a valid `tx`
+        straight into `view` without touching the queue,
+        in which case the outcome is the same as calling
+        `ripple::apply` with the same flags.
+
+        Used to commit transactions that were applied
+        speculatively to a sandbox over `view`.
+    */
+    bool
+    canApplyDirectly(Application& app, OpenView const& view,
+        STTx const& tx, ApplyFlags flags, beast::Journal j);
+
     /**
         Fill the new open ledger with transactions from the queue.
         As we apply more transactions to the ledger, the required
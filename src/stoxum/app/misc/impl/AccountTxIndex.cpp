@@ -0,0 +1,825 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2017 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <stoxum/app/misc/AccountTxIndex.h>
+#include <stoxum/basics/Log.h>
+#include <stoxum/basics/contract.h>
+#include <stoxum/core/Config.h>
+#include <stoxum/core/DatabaseCon.h>
+#include <stoxum/core/JobQueue.h>
+#include <boost/filesystem.hpp>
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+namespace ripple {
+
+namespace fs = boost::filesystem;
+
+using Record = AccountTxIndex::Record;
+using Posting = AccountTxIndex::Posting;
+
+namespace {
+
+// Records per block of the sparse index
+std::size_t constexpr blockSize = 256;
+
+// Pulls records from a sorted source, returning false at the end
+using Source = std::function<bool(Record&)>;
+
+Record
+encode (AccountID const& account, std::uint32_t ledgerSeq,
+    std::uint32_t txnSeq, std::uint8_t const* txID)
+{
+    Record r;
+    auto out = r.data();
+    std::memcpy (out, account.data(), account.size());
+    out += account.size();
+    for (auto v : { ledgerSeq, txnSeq })
+    {
+        *out++ = static_cast<std::uint8_t> (v >> 24);
+        *out++ = static_cast<std::uint8_t> (v >> 16);
+        *out++ = static_cast<std::uint8_t> (v >> 8);
+        *out++ = static_cast<std::uint8_t> (v);
+    }
+    std::memcpy (out, txID, uint256::bytes);
+    return r;
+}
+
+Record
+encode (Posting const& p)
+{
+    return encode (p.account, p.ledgerSeq, p.txnSeq, p.txID.data());
+}
+
+// The first or last possible record at a position
+Record
+bound (AccountID const& account, std::uint32_t ledgerSeq,
+    std::uint32_t txnSeq, bool last)
+{
+    std::uint8_t txID[uint256::bytes];
+    std::memset (txID, last ? 0xff : 0, sizeof(txID));
+    return encode (account, ledgerSeq, txnSeq, txID);
+}
+
+std::uint32_t
+get32 (std::uint8_t const* p)
+{
+    return (std::uint32_t (p[0]) << 24) | (std::uint32_t (p[1]) << 16) |
+        (std::uint32_t (p[2]) << 8) | std::uint32_t (p[3]);
+}
+
+std::uint32_t
+ledgerOf (Record const& r)
+{
+    return get32 (r.data() + AccountID::bytes);
+}
+
+Posting
+decode (Record const& r)
+{
+    Posting p;
+    std::memcpy (p.account.data(), r.data(), AccountID::bytes);
+    p.ledgerSeq = ledgerOf (r);
+    p.txnSeq = get32 (r.data() + AccountID::bytes + 4);
+    std::memcpy (p.txID.data(),
+        r.data() + AccountTxIndex::keySize, uint256::bytes);
+    return p;
+}
+
+// Visits the union of sorted sources in order, once per record
+void
+merge (std::vector<Source>& sources, bool forward,
+    std::function<bool(Record const&)> const& f)
+{
+    std::vector<boost::optional<Record>> heads (sources.size());
+    for (std::size_t i = 0; i < sources.size(); ++i)
+    {
+        Record r;
+        if (sources[i] (r))
+            heads[i] = r;
+    }
+
+    boost::optional<Record> last;
+    for (;;)
+    {
+        boost::optional<std::size_t> best;
+        for (std::size_t i = 0; i < heads.size(); ++i)
+        {
+            if (! heads[i])
+                continue;
+            if (! best || (forward ?
+                    *heads[i] < *heads[*best] : *heads[*best] < *heads[i]))
+                best = i;
+        }
+        if (! best)
+            return;
+
+        Record const r = *heads[*best];
+        Record next;
+        if (sources[*best] (next))
+            heads[*best] = next;
+        else
+            heads[*best].reset();
+
+        if (last && *last == r)
+            continue;
+        last = r;
+        if (! f (r))
+            return;
+    }
+}
+
+Source
+scan (std::shared_ptr<std::vector<Record> const> records,
+    Record const& from, bool forward)
+{
+    auto const& v = *records;
+    if (forward)
+    {
+        std::size_t i = std::lower_bound (
+            v.begin(), v.end(), from) - v.begin();
+        return [records, i](Record& r) mutable
+        {
+            if (i == records->size())
+                return false;
+            r = (*records)[i++];
+            return true;
+        };
+    }
+    std::size_t i = std::upper_bound (
+        v.begin(), v.end(), from) - v.begin();
+    return [records, i](Record& r) mutable
+    {
+        if (i == 0)
+            return false;
+        r = (*records)[--i];
+        return true;
+    };
+}
+
+// Writes a segment file and its sparse index
+class SegmentWriter
+{
+private:
+    fs::path data_;
+    fs::path index_;
+    std::ofstream dataStream_;
+    std::ofstream indexStream_;
+    std::size_t count_ = 0;
+
+public:
+    SegmentWriter (fs::path const& data, fs::path const& index)
+        : data_ (data)
+        , index_ (index)
+    {
+        dataStream_.open ((data_.string() + ".tmp").c_str(),
+            std::ios::binary | std::ios::trunc);
+        indexStream_.open ((index_.string() + ".tmp").c_str(),
+            std::ios::binary | std::ios::trunc);
+        if (! dataStream_ || ! indexStream_)
+            Throw<std::runtime_error> (
+                "Unable to create " + data_.string());
+    }
+
+    void
+    add (Record const& r)
+    {
+        auto const p = reinterpret_cast<char const*> (r.data());
+        if (count_++ % blockSize == 0)
+            indexStream_.write (p, r.size());
+        dataStream_.write (p, r.size());
+    }
+
+    void
+    commit()
+    {
+        dataStream_.close();
+        indexStream_.close();
+        if (! dataStream_ || ! indexStream_)
+            Throw<std::runtime_error> (
+                "Unable to write " + data_.string());
+        fs::rename (data_.string() + ".tmp", data_);
+        fs::rename (index_.string() + ".tmp", index_);
+    }
+};
+
+} // namespace
+
+//------------------------------------------------------------------------------
+
+// An immutable, sorted file of records
+class AccountTxIndex::Segment
+{
+private:
+    fs::path data_;
+    fs::path index_;
+    std::size_t size_ = 0;
+    // The first record of each block
+    std::vector<Record> firsts_;
+    std::mutex mutable mutex_;
+    std::ifstream mutable stream_;
+    bool obsolete_ = false;
+
+public:
+    std::uint64_t const id;
+
+    Segment (std::uint64_t id_, fs::path const& data, fs::path const& index)
+        : data_ (data)
+        , index_ (index)
+        , id (id_)
+    {
+        stream_.open (data_.string().c_str(), std::ios::binary);
+        auto const bytes = fs::file_size (data_);
+        if (! stream_ || bytes % recordSize != 0)
+            Throw<std::runtime_error> ("Bad segment " + data_.string());
+        size_ = bytes / recordSize;
+
+        auto const blocks = (size_ + blockSize - 1) / blockSize;
+        firsts_.resize (blocks);
+        boost::system::error_code ec;
+        if (fs::file_size (index_, ec) == blocks * recordSize && ! ec)
+        {
+            std::ifstream s (index_.string().c_str(), std::ios::binary);
+            s.read (reinterpret_cast<char*> (firsts_.data()),
+                blocks * recordSize);
+            if (s)
+                return;
+        }
+        // Rebuild a missing or damaged index
+        for (std::size_t b = 0; b < blocks; ++b)
+        {
+            stream_.seekg (b * blockSize * recordSize);
+            stream_.read (reinterpret_cast<char*> (
+                firsts_[b].data()), recordSize);
+        }
+        if (! stream_)
+            Throw<std::runtime_error> ("Bad segment " + data_.string());
+    }
+
+    ~Segment()
+    {
+        if (! obsolete_)
+            return;
+        stream_.close();
+        boost::system::error_code ec;
+        fs::remove (data_, ec);
+        fs::remove (index_, ec);
+    }
+
+    // Delete the files once the segment is no longer used
+    void
+    obsolete()
+    {
+        obsolete_ = true;
+    }
+
+    std::size_t
+    blocks() const
+    {
+        return firsts_.size();
+    }
+
+    std::vector<Record>
+    readBlock (std::size_t b) const
+    {
+        auto const first = b * blockSize;
+        std::vector<Record> block (std::min (blockSize, size_ - first));
+        std::lock_guard<std::mutex> lock (mutex_);
+        stream_.clear();
+        stream_.seekg (first * recordSize);
+        stream_.read (reinterpret_cast<char*> (block.data()),
+            block.size() * recordSize);
+        if (! stream_)
+            Throw<std::runtime_error> ("Unable to read " + data_.string());
+        return block;
+    }
+
+    // The block that would hold `r`
+    std::size_t
+    findBlock (Record const& r) const
+    {
+        auto const iter = std::upper_bound (
+            firsts_.begin(), firsts_.end(), r);
+        return iter == firsts_.begin() ? 0 : iter - firsts_.begin() - 1;
+    }
+};
+
+namespace {
+
+Source
+scan (std::shared_ptr<AccountTxIndex::Segment const> seg,
+    Record const& from, bool forward)
+{
+    if (seg->blocks() == 0)
+        return [](Record&) { return false; };
+
+    struct State
+    {
+        std::shared_ptr<AccountTxIndex::Segment const> seg;
+        std::vector<Record> block;
+        std::size_t b;
+        std::size_t i;
+    };
+
+    auto st = std::make_shared<State>();
+    st->seg = std::move (seg);
+    st->b = st->seg->findBlock (from);
+    st->block = st->seg->readBlock (st->b);
+
+    if (forward)
+    {
+        st->i = std::lower_bound (st->block.begin(),
+            st->block.end(), from) - st->block.begin();
+        return [st](Record& r)
+        {
+            while (st->i == st->block.size())
+            {
+                if (st->b + 1 == st->seg->blocks())
+                    return false;
+                st->block = st->seg->readBlock (++st->b);
+                st->i = 0;
+            }
+            r = st->block[st->i++];
+            return true;
+        };
+    }
+
+    st->i = std::upper_bound (st->block.begin(),
+        st->block.end(), from) - st->block.begin();
+    return [st](Record& r)
+    {
+        while (st->i == 0)
+        {
+            if (st->b == 0)
+                return false;
+            st->block = st->seg->readBlock (--st->b);
+            st->i = st->block.size();
+        }
+        r = st->block[--st->i];
+        return true;
+    };
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+
+AccountTxIndex::AccountTxIndex (Setup const& setup,
+    JobQueue* jobQueue, beast::Journal j)
+    : setup_ (setup)
+    , jobQueue_ (jobQueue)
+    , j_ (j)
+{
+}
+
+AccountTxIndex::~AccountTxIndex()
+{
+    std::unique_lock<std::mutex> lock (mutex_);
+    cv_.wait (lock, [this] { return ! working_; });
+}
+
+fs::path
+AccountTxIndex::file (std::uint64_t id, char const* ext) const
+{
+    return setup_.path / (std::to_string (id) + ext);
+}
+
+void
+AccountTxIndex::openLog (std::uint64_t id)
+{
+    log_.close();
+    log_.clear();
+    log_.open (file (id, ".log").string().c_str(),
+        std::ios::binary | std::ios::trunc);
+    if (! log_)
+        Throw<std::runtime_error> (
+            "Unable to create " + file (id, ".log").string());
+    logId_ = id;
+}
+
+void
+AccountTxIndex::writeManifest()
+{
+    auto const path = setup_.path / "MANIFEST";
+    {
+        std::ofstream s ((path.string() + ".tmp").c_str(),
+            std::ios::trunc);
+        s << "floor " << floor_ << '\n';
+        s << "next " << nextId_ << '\n';
+        for (auto const& seg : segments_)
+            s << "segment " << seg->id << '\n';
+        s.close();
+        if (! s)
+            Throw<std::runtime_error> ("Unable to write " + path.string());
+    }
+    fs::rename (path.string() + ".tmp", path);
+}
+
+void
+AccountTxIndex::open (DatabaseCon* txnDB)
+{
+    if (! enabled())
+        return;
+
+    std::unique_lock<std::mutex> lock (mutex_);
+
+    fs::create_directories (setup_.path);
+    auto const manifest = setup_.path / "MANIFEST";
+    bool const fresh = ! fs::exists (manifest);
+
+    std::vector<std::uint64_t> ids;
+    if (! fresh)
+    {
+        std::ifstream s (manifest.string().c_str());
+        std::string key;
+        std::uint64_t value;
+        while (s >> key >> value)
+        {
+            if (key == "floor")
+                floor_ = static_cast<std::uint32_t> (value);
+            else if (key == "next")
+                nextId_ = std::max (nextId_, value);
+            else if (key == "segment")
+                ids.push_back (value);
+        }
+    }
+
+    std::vector<std::uint64_t> logs;
+    for (auto const& entry : fs::directory_iterator (setup_.path))
+    {
+        auto const& path = entry.path();
+        auto const ext = path.extension().string();
+        if (ext == ".tmp")
+        {
+            fs::remove (path);
+            continue;
+        }
+        std::uint64_t id;
+        try
+        {
+            id = std::stoull (path.stem().string());
+        }
+        catch (std::exception const&)
+        {
+            continue;
+        }
+        nextId_ = std::max (nextId_, id + 1);
+        if (ext == ".log")
+            logs.push_back (id);
+        else if (std::find (ids.begin(), ids.end(), id) == ids.end())
+            // Left behind by an interrupted write. The
+            // postings are still in a log or segment.
+            fs::remove (path);
+    }
+
+    for (auto const id : ids)
+        segments_.push_back (std::make_shared<Segment> (
+            id, file (id, ".seg"), file (id, ".idx")));
+
+    // Recover the postings that were only in memory
+    std::sort (logs.begin(), logs.end());
+    for (auto const id : logs)
+    {
+        std::ifstream s (file (id, ".log").string().c_str(),
+            std::ios::binary);
+        Record r;
+        while (s.read (reinterpret_cast<char*> (r.data()), r.size()))
+            if (ledgerOf (r) >= floor_)
+                table_.insert (r);
+    }
+    if (! table_.empty())
+    {
+        JLOG (j_.info()) << "Recovered " << table_.size() << " postings";
+        auto const id = nextId_++;
+        SegmentWriter w (file (id, ".seg"), file (id, ".idx"));
+        for (auto const& r : table_)
+            w.add (r);
+        w.commit();
+        segments_.push_back (std::make_shared<Segment> (
+            id, file (id, ".seg"), file (id, ".idx")));
+        table_.clear();
+    }
+
+    openLog (nextId_++);
+    writeManifest();
+    for (auto const id : logs)
+        fs::remove (file (id, ".log"));
+    lock.unlock();
+
+    if (! fresh || ! txnDB)
+        return;
+
+    JLOG (j_.warn()) << "Importing the AccountTransactions table";
+    std::size_t count = 0;
+    {
+        auto db = txnDB->checkoutDb();
+
+        boost::optional<std::string> txID;
+        boost::optional<std::string> account;
+        boost::optional<std::uint64_t> ledgerSeq;
+        boost::optional<std::uint32_t> txnSeq;
+
+        soci::statement st = (db->prepare <<
+            "SELECT TransID, Account, LedgerSeq, TxnSeq "
+            "FROM AccountTransactions;",
+            soci::into (txID),
+            soci::into (account),
+            soci::into (ledgerSeq),
+            soci::into (txnSeq));
+
+        std::vector<Posting> batch;
+        st.execute();
+        while (st.fetch())
+        {
+            Posting p;
+            auto const id = parseBase58<AccountID> (account.value_or (""));
+            if (! id || ! p.txID.SetHexExact (txID.value_or ("")))
+                continue;
+            p.account = *id;
+            p.ledgerSeq = rangeCheckedCast<std::uint32_t> (
+                ledgerSeq.value_or (0));
+            p.txnSeq = txnSeq.value_or (0);
+            batch.push_back (p);
+            if (batch.size() == blockSize)
+            {
+                insert (batch);
+                batch.clear();
+            }
+            if (++count % 1000000 == 0)
+                JLOG (j_.warn()) << "Imported " << count << " postings";
+        }
+        insert (batch);
+    }
+    flush();
+    JLOG (j_.warn()) << "Imported " << count << " postings";
+}
+
+void
+AccountTxIndex::insert (std::vector<Posting> const& postings)
+{
+    if (! enabled())
+        return;
+
+    bool start = false;
+    {
+        std::lock_guard<std::mutex> lock (mutex_);
+        for (auto const& p : postings)
+        {
+            if (p.ledgerSeq < floor_)
+                continue;
+            auto const r = encode (p);
+            if (table_.insert (r).second)
+                log_.write (reinterpret_cast<char const*> (
+                    r.data()), r.size());
+        }
+        log_.flush();
+        if (! log_)
+            JLOG (j_.error()) << "Unable to write the account_tx log";
+        if (table_.size() >= setup_.flushPostings)
+            start = freeze();
+    }
+    if (start)
+        schedule();
+}
+
+bool
+AccountTxIndex::freeze()
+{
+    if (table_.empty())
+        return false;
+    frozen_.emplace_back (logId_, std::make_shared<
+        std::vector<Record> const> (table_.begin(), table_.end()));
+    table_.clear();
+    openLog (nextId_++);
+    if (working_)
+        return false;
+    working_ = true;
+    return true;
+}
+
+void
+AccountTxIndex::schedule()
+{
+    if (jobQueue_ && jobQueue_->addJob (jtACCOUNT_TX,
+            "AccountTxIndex::work", [this](Job&) { work(); }))
+        return;
+    work();
+}
+
+void
+AccountTxIndex::work()
+{
+    for (;;)
+    {
+        std::pair<std::uint64_t,
+            std::shared_ptr<std::vector<Record> const>> table;
+        std::vector<std::shared_ptr<Segment>> merging;
+        std::uint64_t id;
+        std::uint32_t floor;
+        {
+            std::lock_guard<std::mutex> lock (mutex_);
+            if (! frozen_.empty())
+            {
+                table = frozen_.front();
+                id = table.first;
+            }
+            else if (segments_.size() > setup_.maxSegments)
+            {
+                merging = segments_;
+                id = nextId_++;
+            }
+            else
+            {
+                working_ = false;
+                cv_.notify_all();
+                return;
+            }
+            floor = floor_;
+        }
+
+        try
+        {
+            SegmentWriter w (file (id, ".seg"), file (id, ".idx"));
+            if (table.second)
+            {
+                for (auto const& r : *table.second)
+                    w.add (r);
+            }
+            else
+            {
+                std::vector<Source> sources;
+                for (auto const& seg : merging)
+                    sources.push_back (scan (seg, Record{}, true));
+                merge (sources, true,
+                    [&w, floor](Record const& r)
+                    {
+                        if (ledgerOf (r) >= floor)
+                            w.add (r);
+                        return true;
+                    });
+            }
+            w.commit();
+
+            auto seg = std::make_shared<Segment> (
+                id, file (id, ".seg"), file (id, ".idx"));
+
+            std::lock_guard<std::mutex> lock (mutex_);
+            if (table.second)
+            {
+                segments_.push_back (std::move (seg));
+                frozen_.erase (frozen_.begin());
+            }
+            else
+            {
+                for (auto const& old : merging)
+                {
+                    segments_.erase (std::find (
+                        segments_.begin(), segments_.end(), old));
+                    old->obsolete();
+                }
+                segments_.insert (segments_.begin(), std::move (seg));
+            }
+            writeManifest();
+            if (table.second)
+                fs::remove (file (id, ".log"));
+            JLOG (j_.debug()) << "Wrote segment " << id;
+        }
+        catch (std::exception const& e)
+        {
+            // Unwritten postings stay in memory and in their log
+            JLOG (j_.fatal()) << "Unable to write segment " << id <<
+                ": " << e.what();
+            std::lock_guard<std::mutex> lock (mutex_);
+            working_ = false;
+            cv_.notify_all();
+            return;
+        }
+    }
+}
+
+void
+AccountTxIndex::flush()
+{
+    if (! enabled())
+        return;
+
+    bool start;
+    {
+        std::lock_guard<std::mutex> lock (mutex_);
+        start = freeze();
+    }
+    if (start)
+        schedule();
+
+    std::unique_lock<std::mutex> lock (mutex_);
+    cv_.wait (lock, [this] { return ! working_; });
+}
+
+void
+AccountTxIndex::deleteBefore (std::uint32_t seq)
+{
+    if (! enabled())
+        return;
+
+    std::lock_guard<std::mutex> lock (mutex_);
+    if (seq <= floor_)
+        return;
+    floor_ = seq;
+    writeManifest();
+}
+
+std::size_t
+AccountTxIndex::segments() const
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+    return segments_.size();
+}
+
+void
+AccountTxIndex::forEach (AccountID const& account,
+    std::uint32_t minLedger, std::uint32_t maxLedger,
+        bool forward, boost::optional<Marker> const& start,
+            std::function<bool(Posting const&)> const& f) const
+{
+    if (! enabled())
+        return;
+
+    std::vector<Source> sources;
+    Record from;
+    std::uint32_t lowest;
+    {
+        std::lock_guard<std::mutex> lock (mutex_);
+
+        lowest = std::max (minLedger, floor_);
+        if (lowest > maxLedger)
+            return;
+
+        if (forward)
+            from = (start && start->first >= lowest) ?
+                bound (account, start->first, start->second, false) :
+                bound (account, lowest, 0, false);
+        else
+            from = (start && start->first <= maxLedger) ?
+                bound (account, start->first, start->second, true) :
+                bound (account, maxLedger, 0xffffffff, true);
+
+        // The account's part of the in-memory table is small
+        auto const first = table_.lower_bound (
+            bound (account, lowest, 0, false));
+        auto const last = table_.upper_bound (
+            bound (account, maxLedger, 0xffffffff, true));
+        sources.push_back (scan (std::make_shared<
+            std::vector<Record> const> (first, last), from, forward));
+
+        for (auto const& table : frozen_)
+            sources.push_back (scan (table.second, from, forward));
+        for (auto const& seg : segments_)
+            sources.push_back (scan (seg, from, forward));
+    }
+
+    merge (sources, forward,
+        [&](Record const& r)
+        {
+            auto const p = decode (r);
+            if (p.account != account ||
+                    p.ledgerSeq < lowest || p.ledgerSeq > maxLedger)
+                return false;
+            return f (p);
+        });
+}
+
+//------------------------------------------------------------------------------
+
+AccountTxIndex::Setup
+setup_AccountTxIndex (Config const& config)
+{
+    AccountTxIndex::Setup setup;
+    auto const& section = config.section ("account_tx_index");
+    std::string path;
+    if (get_if_exists (section, "path", path))
+        setup.path = path;
+    get_if_exists (section, "flush_postings", setup.flushPostings);
+    get_if_exists (section, "max_segments", setup.maxSegments);
+    setup.flushPostings = std::max<std::size_t> (setup.flushPostings, 1);
+    return setup;
+}
+
+} // ripple
@@ -26,6 +26,7 @@
 #include <stoxum/protocol/Serializer.h>
 #include <stoxum/protocol/types.h>
 #include <boost/format.hpp>
+#include <limits>
 #include <memory>
 
 namespace ripple {
@@ -280,4 +281,166 @@ accountTxPage (
     return;
 }
 
+namespace {
+
+// Looks up the stored transaction of a posting. Returns
+// false if the transaction is not stored in that ledger.
+bool
+fetchPosting (
+    soci::session& session,
+    AccountTxIndex::Posting const& posting,
+    std::function<void (std::uint32_t)> const& onUnsavedLedger,
+    std::function<void (std::uint32_t,
+                        std::string const&,
+                        Blob const&,
+                        Blob const&)> const& onTransaction)
+{
+    boost::optional<std::uint64_t> ledgerSeq;
+    boost::optional<std::string> status;
+    soci::blob txnData (session);
+    soci::blob txnMeta (session);
+    soci::indicator dataPresent, metaPresent;
+
+    session << boost::str (boost::format (
+            "SELECT LedgerSeq,Status,RawTxn,TxnMeta "
+            "FROM Transactions WHERE TransID = '%s';") %
+                to_string (posting.txID)),
+        soci::into (ledgerSeq),
+        soci::into (status),
+        soci::into (txnData, dataPresent),
+        soci::into (txnMeta, metaPresent);
+
+    if (! session.got_data() || ledgerSeq.value_or (0) != posting.ledgerSeq)
+        return false;
+
+    Blob rawData;
+    Blob rawMeta;
+    if (dataPresent == soci::i_ok)
+        convert (txnData, rawData);
+    if (metaPresent == soci::i_ok)
+        convert (txnMeta, rawMeta);
+
+    // Work around a bug that could leave the metadata missing
+    if (rawMeta.size() == 0)
+        onUnsavedLedger (posting.ledgerSeq);
+
+    onTransaction (posting.ledgerSeq, status.value_or (""),
+        rawData, rawMeta);
+    return true;
+}
+
+std::uint32_t
+lowerLedger (std::int32_t ledger)
+{
+    return ledger < 0 ? 0 : static_cast<std::uint32_t> (ledger);
+}
+
+std::uint32_t
+upperLedger (std::int32_t ledger)
+{
+    return ledger < 0 ? std::numeric_limits<std::uint32_t>::max() :
+        static_cast<std::uint32_t> (ledger);
+}
+
+} // namespace
+
+void
+accountTxIndexPage (
+    DatabaseCon& connection,
+    AccountTxIndex const& index,
+    std::function<void (std::uint32_t)> const& onUnsavedLedger,
+    std::function<void (std::uint32_t,
+                        std::string const&,
+                        Blob const&,
+                        Blob const&)> const& onTransaction,
+    AccountID const& account,
+    std::int32_t minLedger,
+    std::int32_t maxLedger,
+    bool forward,
+    Json::Value& token,
+    int limit,
+    bool bAdmin,
+    std::uint32_t page_length)
+{
+    std::uint32_t numberOfResults;
+
+    if (limit <= 0 || (limit > page_length && !bAdmin))
+        numberOfResults = page_length;
+    else
+        numberOfResults = limit;
+
+    boost::optional<AccountTxIndex::Marker> marker;
+    if (!token.isNull() && token.isObject())
+    {
+        try
+        {
+            if (!token.isMember(jss::ledger) || !token.isMember(jss::seq))
+                return;
+            marker.emplace (token[jss::ledger].asUInt(),
+                token[jss::seq].asUInt());
+        }
+        catch (std::exception const&)
+        {
+            return;
+        }
+    }
+
+    token = Json::nullValue;
+
+    auto db (connection.checkoutDb());
+
+    index.forEach (account, lowerLedger (minLedger), upperLedger (maxLedger),
+        forward, marker,
+        [&](AccountTxIndex::Posting const& posting)
+        {
+            if (numberOfResults == 0)
+            {
+                token = Json::objectValue;
+                token[jss::ledger] = posting.ledgerSeq;
+                token[jss::seq] = posting.txnSeq;
+                return false;
+            }
+
+            if (fetchPosting (*db, posting, onUnsavedLedger, onTransaction))
+                --numberOfResults;
+            return true;
+        });
+}
+
+void
+accountTxIndexRange (
+    DatabaseCon& connection,
+    AccountTxIndex const& index,
+    std::function<void (std::uint32_t)> const& onUnsavedLedger,
+    std::function<void (std::uint32_t,
+                        std::string const&,
+                        Blob const&,
+                        Blob const&)> const& onTransaction,
+    AccountID const& account,
+    std::int32_t minLedger,
+    std::int32_t maxLedger,
+    bool forward,
+    std::uint32_t offset,
+    std::uint32_t count)
+{
+    if (count == 0)
+        return;
+
+    auto db (connection.checkoutDb());
+
+    index.forEach (account, lowerLedger (minLedger), upperLedger (maxLedger),
+        forward, boost::none,
+        [&](AccountTxIndex::Posting const& posting)
+        {
+            if (offset != 0)
+            {
+                --offset;
+                return true;
+            }
+            if (fetchPosting (*db, posting, onUnsavedLedger, onTransaction))
+                --count;
+            return count != 0;
+        });
+}
+
 }
@@ -21,6 +21,7 @@
 #define RIPPLE_APP_MISC_IMPL_ACCOUNTTXPAGING_H_INCLUDED
 
 #include <stoxum/core/DatabaseCon.h>
+#include <stoxum/app/misc/AccountTxIndex.h>
 #include <stoxum/app/misc/NetworkOPs.h>
 #include <cstdint>
 #include <string>
@@ -61,6 +62,45 @@ accountTxPage (
     bool bAdmin,
     std::uint32_t pageLength);
 
+/** Like accountTxPage, finding the transactions with the index. */
+void
+accountTxIndexPage (
+    DatabaseCon& database,
+    AccountTxIndex const& index,
+    std::function<void (std::uint32_t)> const& onUnsavedLedger,
+    std::function<void (std::uint32_t,
+                        std::string const&,
+                        Blob const&,
+                        Blob const&)> const&,
+    AccountID const& account,
+    std::int32_t minLedger,
+    std::int32_t maxLedger,
+    bool forward,
+    Json::Value& token,
+    int limit,
+    bool bAdmin,
+    std::uint32_t pageLength);
+
+/** Visit `count` of an account's transactions, after skipping `offset`.
+
+    A negative `minLedger` or `maxLedger` leaves that end open.
+*/
+void
+accountTxIndexRange (
+    DatabaseCon& database,
+    AccountTxIndex const& index,
+    std::function<void (std::uint32_t)> const& onUnsavedLedger,
+    std::function<void (std::uint32_t,
+                        std::string const&,
+                        Blob const&,
+                        Blob const&)> const&,
+    AccountID const& account,
+    std::int32_t minLedger,
+    std::int32_t maxLedger,
+    bool forward,
+    std::uint32_t offset,
+    std::uint32_t count);
+
 }
 
 #endif
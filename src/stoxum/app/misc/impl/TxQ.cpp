@@ -1127,6 +1127,40 @@ TxQ::apply(Application& app, OpenView& view,
     return { terQUEUED, false };
 }
 
+/*
+    Mirrors the path through `apply` that ends in `doApply`
+    on the open ledger: the account has nothing queued, so
+    there is no replacement or multi-transaction handling,
+    and the fee level is high enough to skip the queue.
+    `fix1513` must be enabled so `apply` and `ripple::apply`
+    agree on the amount switchover.
+*/
+bool
+TxQ::canApplyDirectly(Application& app, OpenView const& view,
+    STTx const& tx, ApplyFlags flags, beast::Journal j)
+{
+    if (!view.rules().enabled(featureFeeEscalation))
+        return true;
+    if (!view.rules().enabled(fix1513))
+        return false;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (byAccount_.find(tx[sfAccount]) != byAccount_.end())
+        return false;
+
+    auto const metricsSnapshot = feeMetrics_.getSnapshot();
+    auto const baseFee = calculateBaseFee(app, view, tx, j);
+    auto const feeLevelPaid = getFeeLevelPaid(tx,
+        baseLevel, baseFee, setup_);
+    auto requiredFeeLevel = FeeMetrics::scaleFeeLevel(
+        metricsSnapshot, view);
+    if ((flags & tapPREFER_QUEUE) && byFee_.size())
+        requiredFeeLevel = std::max(requiredFeeLevel,
+            byFee_.begin()->feeLevel);
+    return feeLevelPaid >= requiredFeeLevel;
+}
+
 /*
     0. Is `featureFeeEscalation` enabled?
         Yes: Continue to next step.
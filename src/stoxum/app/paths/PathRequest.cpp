@@ -22,6 +22,8 @@
 #include <stoxum/app/paths/RippleCalc.h>
 #include <stoxum/app/paths/PathRequest.h>
 #include <stoxum/app/paths/PathRequests.h>
+#include <stoxum/app/paths/Tuning.h>
+#include <stoxum/app/paths/impl/ParallelFor.h>
 #include <stoxum/app/main/Application.h>
 #include <stoxum/app/misc/LoadFeeTrack.h>
 #include <stoxum/app/misc/NetworkOPs.h>
@@ -455,15 +457,10 @@ Json::Value PathRequest::doStatus (Json::Value const&)
     return jvStatus;
 }
 
-std::unique_ptr<Pathfinder> const&
-PathRequest::getPathFinder(std::shared_ptr<RippleLineCache> const& cache,
-    hash_map<Currency, std::unique_ptr<Pathfinder>>& currency_map,
-        Currency const& currency, STAmount const& dst_amount,
-            int const level)
+std::unique_ptr<Pathfinder>
+PathRequest::makePathFinder(std::shared_ptr<RippleLineCache> const& cache,
+    Currency const& currency, STAmount const& dst_amount, int const level)
 {
-    auto i = currency_map.find(currency);
-    if (i != currency_map.end())
-        return i->second;
     auto pathfinder = std::make_unique<Pathfinder>(
         cache, *raSrcAccount, *raDstAccount, currency,
             boost::none, dst_amount, saSendMax, app_);
@@ -471,7 +468,102 @@ PathRequest::getPathFinder(std::shared_ptr<RippleLineCache> const& cache,
         pathfinder->computePathRanks(max_paths_);
     else
         pathfinder.reset();  // It's a bad request - clear it.
-    return currency_map[currency] = std::move(pathfinder);
+    return pathfinder;
+}
+
+boost::optional<Json::Value>
+PathRequest::findIssuePaths (std::shared_ptr<RippleLineCache> const& cache,
+    Pathfinder& pathfinder, Issue const& issue, STAmount const& dst_amount,
+        STPathSet& paths)
+{
+    STPath fullLiquidityPath;
+    auto ps = pathfinder.getBestPaths(max_paths_,
+        fullLiquidityPath, paths, issue.account);
+    paths = ps;
+
+    auto& sourceAccount = ! isXRP(issue.account)
+        ? issue.account
+        : isXRP(issue.currency)
+        ? xrpAccount()
+        : *raSrcAccount;
+    STAmount saMaxAmount = saSendMax.value_or(
+        STAmount({issue.currency, sourceAccount}, 1u, 0, true));
+
+    JLOG(m_journal.debug()) << iIdentifier
+        << " Paths found, calling rippleCalc";
+
+    path::RippleCalc::Input rcInput;
+    if (convert_all_)
+        rcInput.partialPaymentAllowed = true;
+    auto sandbox = std::make_unique<PaymentSandbox>
+        (&*cache->getLedger(), tapNONE);
+    auto rc = path::RippleCalc::rippleCalculate(
+        *sandbox,
+        saMaxAmount,    // --> Amount to send is unlimited
+                        //     to get an estimate.
+        dst_amount,     // --> Amount to deliver.
+        *raDstAccount,  // --> Account to deliver to.
+        *raSrcAccount,  // --> Account sending from.
+        ps,             // --> Path set.
+        app_.logs(),
+        &rcInput);
+
+    if (! convert_all_ &&
+        ! fullLiquidityPath.empty() &&
+        (rc.result() == terNO_LINE || rc.result() == tecPATH_PARTIAL))
+    {
+        JLOG(m_journal.debug()) << iIdentifier
+            << " Trying with an extra path element";
+
+        ps.push_back(fullLiquidityPath);
+        sandbox = std::make_unique<PaymentSandbox>
+            (&*cache->getLedger(), tapNONE);
+        rc = path::RippleCalc::rippleCalculate(
+            *sandbox,
+            saMaxAmount,    // --> Amount to send is unlimited
+                            //     to get an estimate.
+            dst_amount,     // --> Amount to deliver.
+            *raDstAccount,  // --> Account to deliver to.
+            *raSrcAccount,  // --> Account sending from.
+            ps,             // --> Path set.
+            app_.logs());
+
+        if (rc.result() != tesSUCCESS)
+        {
+            JLOG(m_journal.warn()) << iIdentifier
+                << " Failed with covering path "
+                << transHuman(rc.result());
+        }
+        else
+        {
+            JLOG(m_journal.debug()) << iIdentifier
+                << " Extra path element gives "
+                << transHuman(rc.result());
+        }
+    }
+
+    if (rc.result () == tesSUCCESS)
+    {
+        Json::Value jvEntry (Json::objectValue);
+        rc.actualAmountIn.setIssuer (sourceAccount);
+        jvEntry[jss::source_amount] = rc.actualAmountIn.getJson (0);
+        jvEntry[jss::paths_computed] = ps.getJson(0);
+
+        if (convert_all_)
+            jvEntry[jss::destination_amount] = rc.actualAmountOut.getJson(0);
+
+        if (hasCompletion ())
+        {
+            // Old ripple_path_find API requires this
+            jvEntry[jss::paths_canonical] = Json::arrayValue;
+        }
+
+        return jvEntry;
+    }
+
+    JLOG(m_journal.debug()) << iIdentifier << " rippleCalc returns "
+        << transHuman(rc.result());
+    return boost::none;
 }
 
 bool
@@ -498,112 +590,73 @@ PathRequest::findPaths (std::shared_ptr<RippleLineCache> const& cache,
     auto const dst_amount = convert_all_ ?
         STAmount(saDstAmount.issue(), STAmount::cMaxValue, STAmount::cMaxOffset)
             : saDstAmount;
-    hash_map<Currency, std::unique_ptr<Pathfinder>> currency_map;
+
+    // The source issues of a currency share its pathfinder, and the
+    // pathfinders, then the issues, are searched in parallel over the
+    // same ledger. Results are gathered in the order of the issues.
+    hash_map<Currency, std::size_t> finderIndex;
+    std::vector<Currency> currencies;
     for (auto const& issue : sourceCurrencies)
     {
-        JLOG(m_journal.debug())
-            << iIdentifier
-            << " Trying to find paths: "
-            << STAmount(issue, 1).getFullText();
-
-        auto& pathfinder = getPathFinder(cache, currency_map,
-            issue.currency, dst_amount, level);
-        if (! pathfinder)
-        {
-            assert(false);
-            JLOG(m_journal.debug()) << iIdentifier << " No paths found";
-            continue;
-        }
-
-        STPath fullLiquidityPath;
-        auto ps = pathfinder->getBestPaths(max_paths_,
-            fullLiquidityPath, mContext[issue], issue.account);
-        mContext[issue] = ps;
-
-        auto& sourceAccount = ! isXRP(issue.account)
-            ? issue.account
-            : isXRP(issue.currency)
-            ? xrpAccount()
-            : *raSrcAccount;
-        STAmount saMaxAmount = saSendMax.value_or(
-            STAmount({issue.currency, sourceAccount}, 1u, 0, true));
-
-        JLOG(m_journal.debug()) << iIdentifier
-            << " Paths found, calling rippleCalc";
-
-        path::RippleCalc::Input rcInput;
-        if (convert_all_)
-            rcInput.partialPaymentAllowed = true;
-        auto sandbox = std::make_unique<PaymentSandbox>
-            (&*cache->getLedger(), tapNONE);
-        auto rc = path::RippleCalc::rippleCalculate(
-            *sandbox,
-            saMaxAmount,    // --> Amount to send is unlimited
-                            //     to get an estimate.
-            dst_amount,     // --> Amount to deliver.
-            *raDstAccount,  // --> Account to deliver to.
-            *raSrcAccount,  // --> Account sending from.
-            ps,             // --> Path set.
-            app_.logs(),
-            &rcInput);
+        if (finderIndex.emplace (issue.currency, currencies.size()).second)
+            currencies.push_back (issue.currency);
+    }
 
-        if (! convert_all_ &&
-            ! fullLiquidityPath.empty() &&
-            (rc.result() == terNO_LINE || rc.result() == tecPATH_PARTIAL))
+    std::vector<std::unique_ptr<Pathfinder>> pathfinders (currencies.size());
+    path::parallelFor (app_.getJobQueue(), jtPATH_SEARCH, "findPaths",
+        currencies.size(), PATHFINDER_HELPER_JOBS,
+        [&](std::size_t i)
         {
-            JLOG(m_journal.debug()) << iIdentifier
-                << " Trying with an extra path element";
-
-            ps.push_back(fullLiquidityPath);
-            sandbox = std::make_unique<PaymentSandbox>
-                (&*cache->getLedger(), tapNONE);
-            rc = path::RippleCalc::rippleCalculate(
-                *sandbox,
-                saMaxAmount,    // --> Amount to send is unlimited
-                                //     to get an estimate.
-                dst_amount,     // --> Amount to deliver.
-                *raDstAccount,  // --> Account to deliver to.
-                *raSrcAccount,  // --> Account sending from.
-                ps,             // --> Path set.
-                app_.logs());
-
-            if (rc.result() != tesSUCCESS)
-            {
-                JLOG(m_journal.warn()) << iIdentifier
-                    << " Failed with covering path "
-                    << transHuman(rc.result());
-            }
-            else
-            {
-                JLOG(m_journal.debug()) << iIdentifier
-                    << " Extra path element gives "
-                    << transHuman(rc.result());
-            }
-        }
+            pathfinders[i] = makePathFinder (cache, currencies[i],
+                dst_amount, level);
+        });
+
+    struct Search
+    {
+        Issue issue;
+        Pathfinder* pathfinder;
+        STPathSet paths;
+        boost::optional<Json::Value> entry;
+    };
+    std::vector<Search> searches;
+    searches.reserve (sourceCurrencies.size());
+    for (auto const& issue : sourceCurrencies)
+    {
+        auto const context = mContext.find (issue);
+        searches.push_back ({issue,
+            pathfinders[finderIndex[issue.currency]].get(),
+                context == mContext.end() ? STPathSet() : context->second,
+                    boost::none});
+    }
 
-        if (rc.result () == tesSUCCESS)
+    path::parallelFor (app_.getJobQueue(), jtPATH_SEARCH, "findPaths",
+        searches.size(), PATHFINDER_HELPER_JOBS,
+        [&](std::size_t i)
         {
-            Json::Value jvEntry (Json::objectValue);
-            rc.actualAmountIn.setIssuer (sourceAccount);
-            jvEntry[jss::source_amount] = rc.actualAmountIn.getJson (0);
-            jvEntry[jss::paths_computed] = ps.getJson(0);
-
-            if (convert_all_)
-                jvEntry[jss::destination_amount] = rc.actualAmountOut.getJson(0);
+            auto& search = searches[i];
+            JLOG(m_journal.debug())
+                << iIdentifier
+                << " Trying to find paths: "
+                << STAmount(search.issue, 1).getFullText();
 
-            if (hasCompletion ())
+            if (! search.pathfinder)
             {
-                // Old ripple_path_find API requires this
-                jvEntry[jss::paths_canonical] = Json::arrayValue;
+                assert(false);
+                JLOG(m_journal.debug()) << iIdentifier << " No paths found";
+                return;
             }
 
-            jvArray.append (jvEntry);
-        }
-        else
-        {
-            JLOG(m_journal.debug()) << iIdentifier << " rippleCalc returns "
-                << transHuman(rc.result());
-        }
+            search.entry = findIssuePaths (cache, *search.pathfinder,
+                search.issue, dst_amount, search.paths);
+        });
+
+    for (auto& search : searches)
+    {
+        if (! search.pathfinder)
+            continue;
+        mContext[search.issue] = std::move (search.paths);
+        if (search.entry)
+            jvArray.append (std::move (*search.entry));
     }
 
     /*  The resource fee is based on the number of source currencies used.
@@ -616,8 +669,55 @@ PathRequest::findPaths (std::shared_ptr<RippleLineCache> const& cache,
     return true;
 }
 
+bool
+PathRequest::findPathsAnytime (std::shared_ptr<RippleLineCache> const& cache,
+    Json::Value const& status, Progress const& progress,
+        Json::Value& jvArray)
+{
+    using namespace std::chrono;
+    auto const deadline = steady_clock::now() +
+        app_.config().PATH_SEARCH_BUDGET;
+    int const target = iLevel;
+
+    // The alternatives the subscriber has now
+    Json::Value reported;
+    {
+        ScopedLockType sl (mLock);
+        reported = jvStatus[jss::alternatives];
+    }
+
+    for (int level = std::min (app_.config().PATH_SEARCH_FAST + 1, target);
+        ; ++level)
+    {
+        jvArray = Json::arrayValue;
+        if (! findPaths (cache, level, jvArray))
+            return false;
+
+        if (level >= target)
+            return true;
+
+        if (steady_clock::now() >= deadline)
+        {
+            JLOG(m_journal.debug()) << iIdentifier
+                << " search budget spent at level " << level;
+            iLevel = level;
+            return true;
+        }
+
+        if (jvArray != reported)
+        {
+            Json::Value update = status;
+            update[jss::alternatives] = jvArray;
+            update[jss::full_reply] = false;
+            progress (update);
+            reported = jvArray;
+        }
+    }
+}
+
 Json::Value PathRequest::doUpdate(
-    std::shared_ptr<RippleLineCache> const& cache, bool fast)
+    std::shared_ptr<RippleLineCache> const& cache, bool fast,
+    Progress const& progress)
 {
     using namespace std::chrono;
     JLOG(m_journal.debug()) << iIdentifier
@@ -685,8 +785,14 @@ Json::Value PathRequest::doUpdate(
     JLOG(m_journal.debug()) << iIdentifier
         << " processing at level " << iLevel;
 
+    // A subscription's first full search may report as it goes
+    bool const anytime = ! fast && progress &&
+        app_.config().PATH_SEARCH_BUDGET.count() > 0 &&
+            full_reply_ == steady_clock::time_point{};
+
     Json::Value jvArray = Json::arrayValue;
-    if (findPaths(cache, iLevel, jvArray))
+    if (anytime ? findPathsAnytime(cache, newStatus, progress, jvArray)
+        : findPaths(cache, iLevel, jvArray))
     {
         bLastSuccess = jvArray.size() != 0;
         newStatus[jss::alternatives] = std::move (jvArray);
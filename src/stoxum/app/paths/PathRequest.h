@@ -27,6 +27,7 @@
 #include <stoxum/net/InfoSub.h>
 #include <stoxum/protocol/types.h>
 #include <boost/optional.hpp>
+#include <functional>
 #include <map>
 #include <mutex>
 #include <set>
@@ -94,9 +95,13 @@ public:
     Json::Value doClose (Json::Value const&);
     Json::Value doStatus (Json::Value const&);
 
+    // Receives the better alternatives found while a search continues
+    using Progress = std::function <void (Json::Value const&)>;
+
     // update jvStatus
     Json::Value doUpdate (
-        std::shared_ptr<RippleLineCache> const&, bool fast);
+        std::shared_ptr<RippleLineCache> const&, bool fast,
+        Progress const& progress = {});
     InfoSub::pointer getSubscriber ();
     bool hasCompletion ();
 
@@ -106,10 +111,18 @@ private:
     bool isValid (std::shared_ptr<RippleLineCache> const& crCache);
     void setValid ();
 
-    std::unique_ptr<Pathfinder> const&
-    getPathFinder(std::shared_ptr<RippleLineCache> const&,
-        hash_map<Currency, std::unique_ptr<Pathfinder>>&, Currency const&,
-            STAmount const&, int const);
+    std::unique_ptr<Pathfinder>
+    makePathFinder(std::shared_ptr<RippleLineCache> const&,
+        Currency const&, STAmount const&, int const);
+
+    /** Finds paths from one source issue with its currency's pathfinder.
+        On entry `paths` holds the paths found last time, and on return
+        the best paths found now. Returns the entry for the result, if
+        the paths can deliver.
+    */
+    boost::optional<Json::Value>
+    findIssuePaths (std::shared_ptr<RippleLineCache> const&,
+        Pathfinder&, Issue const&, STAmount const&, STPathSet& paths);
 
     /** Finds and sets a PathSet in the JSON argument.
         Returns false if the source currencies are inavlid.
@@ -117,6 +130,17 @@ private:
     bool
     findPaths (std::shared_ptr<RippleLineCache> const&, int const, Json::Value&);
 
+    /** Finds paths level by level up to iLevel, within the search budget.
+        Each level's alternatives that differ from the last ones reported
+        are passed to `progress` while the search goes on. The budget is
+        only checked between levels, and if it is spent the search stops
+        there and iLevel is lowered to the level reached.
+    */
+    bool
+    findPathsAnytime (std::shared_ptr<RippleLineCache> const&,
+        Json::Value const& status, Progress const& progress,
+            Json::Value&);
+
     int parseJson (Json::Value const&);
 
     Application& app_;
@@ -49,7 +49,27 @@ PathRequests::getLineCache (
          (authoritative && ((lgrSeq + 8)  < lineSeq)) ||   // we jumped way back for some reason
          (lgrSeq > (lineSeq + 8)))                         // we jumped way forward for some reason
     {
-        mLineCache = std::make_shared<RippleLineCache> (ledger);
+        if (mLineCache)
+        {
+            // Searches served by the cached paths of the last ledger
+            mPathHits += mLineCache->pathHits ();
+            mPathMisses += mLineCache->pathMisses ();
+            JLOG (mJournal.debug()) << "Ledger " << lineSeq << " paths: " <<
+                mLineCache->pathHits () << " cached, " <<
+                mLineCache->pathMisses () << " searched";
+        }
+
+        // A ledger that follows the cached one only changes some lines
+        if (mLineCache && ! ledger->open () &&
+            ledger->info().parentHash == mLineCache->getLedger()->info().hash)
+        {
+            mLineCache = std::make_shared<RippleLineCache> (
+                ledger, *mLineCache);
+        }
+        else
+        {
+            mLineCache = std::make_shared<RippleLineCache> (ledger);
+        }
     }
     return mLineCache;
 }
@@ -100,7 +120,13 @@ void PathRequests::updateAll (std::shared_ptr <ReadView const> const& inLedger,
                     {
                         if (!ipSub->getConsumer ().warn ())
                         {
-                            Json::Value update = request->doUpdate (cache, false);
+                            Json::Value update = request->doUpdate (cache, false,
+                                [&ipSub](Json::Value const& progress)
+                                {
+                                    Json::Value update = progress;
+                                    update[jss::type] = "path_find";
+                                    ipSub->send (update, false);
+                                });
                             request->updateComplete ();
                             update[jss::type] = "path_find";
                             ipSub->send (update, false);
@@ -42,6 +42,8 @@ public:
     {
         mFast = collector->make_event ("pathfind_fast");
         mFull = collector->make_event ("pathfind_full");
+        mPathHits = collector->make_meter ("pathfind_cache_hit");
+        mPathMisses = collector->make_meter ("pathfind_cache_miss");
     }
 
     /** Update all of the contained PathRequest instances.
@@ -97,6 +99,8 @@ private:
 
     beast::insight::Event            mFast;
     beast::insight::Event            mFull;
+    beast::insight::Meter            mPathHits;
+    beast::insight::Meter            mPathMisses;
 
     // Track all requests
     std::vector<PathRequest::wptr> requests_;
@@ -23,6 +23,7 @@
 #include <stoxum/app/paths/Pathfinder.h>
 #include <stoxum/app/paths/RippleCalc.h>
 #include <stoxum/app/paths/RippleLineCache.h>
+#include <stoxum/app/paths/impl/ParallelFor.h>
 #include <stoxum/ledger/PaymentSandbox.h>
 #include <stoxum/app/ledger/OrderBookDB.h>
 #include <stoxum/basics/Log.h>
@@ -299,6 +300,18 @@ bool Pathfinder::findPaths (int searchLevel)
         paymentType = pt_nonXRP_to_nonXRP;
     }
 
+    // Another search of this ledger may have found the paths already
+    RippleLineCache::PathKey const key (mSrcAccount, mDstAccount,
+        mEffectiveDst, mSrcCurrency, mSrcIssuer, mDstAmount.getCurrency (),
+            searchLevel);
+    if (auto const paths = mRLCache->getPaths (key))
+    {
+        mCompletePaths = *paths;
+        JLOG (j_.debug())
+                << mCompletePaths.size () << " complete paths cached";
+        return true;
+    }
+
     // Now iterate over all paths for that paymentType.
     for (auto const& costedPath : mPathTable[paymentType])
     {
@@ -316,6 +329,7 @@ bool Pathfinder::findPaths (int searchLevel)
 
     JLOG (j_.debug())
             << mCompletePaths.size () << " complete paths found";
+    mRLCache->setPaths (key, mCompletePaths);
 
     // Even if we find no paths, default paths may work, and we don't check them
     // currently.
@@ -499,15 +513,33 @@ void Pathfinder::rankPaths (
         saMinDstAmount = smallestUsefulAmount(mDstAmount, maxPaths);
     }
 
+    // Each path is checked against the ledger on its own, so the
+    // checks run in parallel and are ranked in order afterwards.
+    struct Liquidity
+    {
+        TER result = tesSUCCESS;
+        STAmount amount;
+        uint64_t quality = 0;
+    };
+    std::vector<Liquidity> liquidities (paths.size ());
+    path::parallelFor (app_.getJobQueue (), jtPATH_SEARCH, "rankPaths",
+        paths.size (), PATHFINDER_HELPER_JOBS,
+        [&](std::size_t i)
+        {
+            auto& l = liquidities[i];
+            if (! paths[i].empty ())
+                l.result = getPathLiquidity (
+                    paths[i], saMinDstAmount, l.amount, l.quality);
+        });
+
     for (int i = 0; i < paths.size (); ++i)
     {
         auto const& currentPath = paths[i];
         if (! currentPath.empty())
         {
-            STAmount liquidity;
-            uint64_t uQuality;
-            auto const resultCode = getPathLiquidity (
-                currentPath, saMinDstAmount, liquidity, uQuality);
+            auto const& liquidity = liquidities[i].amount;
+            auto const uQuality = liquidities[i].quality;
+            auto const resultCode = liquidities[i].result;
             if (resultCode != tesSUCCESS)
             {
                 JLOG (j_.debug()) <<
@@ -19,7 +19,10 @@
 
 #include <BeastConfig.h>
 #include <stoxum/app/paths/RippleLineCache.h>
+#include <stoxum/app/paths/Tuning.h>
+#include <stoxum/basics/UnorderedContainers.h>
 #include <stoxum/ledger/OpenView.h>
+#include <cassert>
 
 namespace ripple {
 
@@ -32,6 +35,62 @@ RippleLineCache::RippleLineCache(
     mLedger = std::make_shared<OpenView>(&*ledger, ledger);
 }
 
+// The accounts on either side of the trust lines a ledger changed
+static
+hash_set<AccountID>
+changedLineAccounts (ReadView const& ledger)
+{
+    hash_set<AccountID> accounts;
+    for (auto const& item : ledger.txs)
+    {
+        if (! item.second)
+            continue;
+        for (auto const& node : item.second->getFieldArray (sfAffectedNodes))
+        {
+            if (node.getFieldU16 (sfLedgerEntryType) != ltRIPPLE_STATE)
+                continue;
+            int const index = node.getFieldIndex (
+                (node.getFName () == sfCreatedNode) ? sfNewFields : sfFinalFields);
+            if (index == -1)
+                continue;
+            auto const inner = dynamic_cast<STObject const*> (
+                &node.peekAtIndex (index));
+            if (! inner)
+                continue;
+            accounts.insert (inner->getFieldAmount (sfLowLimit).getIssuer ());
+            accounts.insert (inner->getFieldAmount (sfHighLimit).getIssuer ());
+        }
+    }
+    return accounts;
+}
+
+RippleLineCache::RippleLineCache(
+    std::shared_ptr <ReadView const> const& ledger,
+    RippleLineCache& parent)
+    : RippleLineCache (ledger)
+{
+    assert (! ledger->open ());
+    assert (ledger->info ().parentHash == parent.getLedger ()->info ().hash);
+
+    auto const changed = changedLineAccounts (*ledger);
+
+    // The keys are hashed with the parent's hasher
+    hasher_ = parent.hasher_;
+
+    std::lock_guard <std::mutex> sl (parent.mLock);
+
+    // Start over rather than let the cache grow without bound
+    if (parent.lines_.size () > LINE_CACHE_MAX_ACCOUNTS)
+        return;
+
+    lines_.reserve (parent.lines_.size ());
+    for (auto const& entry : parent.lines_)
+    {
+        if (changed.count (entry.first.account_) == 0)
+            lines_.insert (entry);
+    }
+}
+
 std::vector<RippleState::pointer> const&
 RippleLineCache::getRippleLines (AccountID const& accountID)
 {
@@ -39,14 +98,40 @@ RippleLineCache::getRippleLines (AccountID const& accountID)
 
     std::lock_guard <std::mutex> sl (mLock);
 
-    auto it = lines_.emplace (key,
-        std::vector<RippleState::pointer>());
+    auto it = lines_.emplace (key, nullptr);
 
     if (it.second)
-        it.first->second = getRippleStateItems (
-            accountID, *mLedger);
+        it.first->second = std::make_shared<
+            std::vector<RippleState::pointer> const> (
+                getRippleStateItems (accountID, *mLedger));
+
+    return *it.first->second;
+}
+
+RippleLineCache::Paths
+RippleLineCache::getPaths (PathKey const& key)
+{
+    std::lock_guard <std::mutex> sl (mPathLock);
+
+    auto const it = paths_.find (key);
+    if (it == paths_.end ())
+    {
+        ++pathMisses_;
+        return nullptr;
+    }
+    ++pathHits_;
+    return it->second;
+}
+
+void
+RippleLineCache::setPaths (PathKey const& key, STPathSet const& paths)
+{
+    auto p = std::make_shared<STPathSet const> (paths);
+
+    std::lock_guard <std::mutex> sl (mPathLock);
 
-    return it.first->second;
+    if (paths_.size () < LINE_CACHE_MAX_SEARCHES)
+        paths_.emplace (key, std::move (p));
 }
 
 } // ripple
@@ -23,9 +23,14 @@
 #include <stoxum/app/ledger/Ledger.h>
 #include <stoxum/app/paths/RippleState.h>
 #include <stoxum/basics/hardened_hash.h>
+#include <stoxum/protocol/STPathSet.h>
+#include <boost/optional.hpp>
+#include <atomic>
 #include <cstddef>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <tuple>
 #include <vector>
 
 namespace ripple {
@@ -38,6 +43,17 @@ public:
     RippleLineCache (
         std::shared_ptr <ReadView const> const& l);
 
+    /** Create the cache for a ledger from the cache of its parent.
+
+        The lines of accounts whose trust lines the ledger did not
+        change are shared with the parent's cache, so they are not
+        read again. The ledger must be closed, and `parent` must be
+        the cache of the ledger it was built on.
+    */
+    RippleLineCache (
+        std::shared_ptr <ReadView const> const& l,
+        RippleLineCache& parent);
+
     std::shared_ptr <ReadView const> const&
     getLedger () const
     {
@@ -47,6 +63,39 @@ public:
     std::vector<RippleState::pointer> const&
     getRippleLines (AccountID const& accountID);
 
+    /** Identifies a path search in the ledger.
+
+        The source and destination accounts, the effective destination,
+        the source currency and issuer, the destination currency and
+        the search level. The paths a search finds do not depend on the
+        amounts, so clients asking the same question share them.
+    */
+    using PathKey = std::tuple <AccountID, AccountID, AccountID,
+        Currency, boost::optional<AccountID>, Currency, int>;
+
+    using Paths = std::shared_ptr <STPathSet const>;
+
+    /** Return the complete paths found before for a search, if any. */
+    Paths
+    getPaths (PathKey const& key);
+
+    /** Remember the complete paths a search found. */
+    void
+    setPaths (PathKey const& key, STPathSet const& paths);
+
+    /** Searches answered from, and added to, the cached paths. */
+    std::size_t
+    pathHits () const
+    {
+        return pathHits_;
+    }
+
+    std::size_t
+    pathMisses () const
+    {
+        return pathMisses_;
+    }
+
 private:
     std::mutex mLock;
 
@@ -89,10 +138,17 @@ private:
         };
     };
 
+    using Lines = std::shared_ptr <std::vector <RippleState::pointer> const>;
+
     hash_map <
         AccountKey,
-        std::vector <RippleState::pointer>,
+        Lines,
         AccountKey::Hash> lines_;
+
+    std::mutex mPathLock;
+    std::map <PathKey, Paths> paths_;
+    std::atomic <std::size_t> pathHits_ {0};
+    std::atomic <std::size_t> pathMisses_ {0};
 };
 
 } // ripple
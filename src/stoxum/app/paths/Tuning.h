@@ -20,6 +20,8 @@
 #ifndef RIPPLE_APP_PATHS_TUNING_H_INCLUDED
 #define RIPPLE_APP_PATHS_TUNING_H_INCLUDED
 
+#include <cstddef>
+
 namespace ripple {
 
 int const CALC_NODE_DELIVER_MAX_LOOPS = 100;
@@ -31,6 +33,15 @@ int const PATHFINDER_MAX_PATHS = 50;
 int const PATHFINDER_MAX_COMPLETE_PATHS = 1000;
 int const PATHFINDER_MAX_PATHS_FROM_SOURCE = 10;
 
+// Jobs that help one path search, by source currency or candidate path
+std::size_t const PATHFINDER_HELPER_JOBS = 3;
+
+// Most accounts whose trust lines are carried into the next ledger's cache
+std::size_t const LINE_CACHE_MAX_ACCOUNTS = 100000;
+
+// Most path searches whose complete paths are kept for a ledger
+std::size_t const LINE_CACHE_MAX_SEARCHES = 10000;
+
 } // ripple
 
 #endif
@@ -65,6 +65,12 @@ protected:
 
     boost::optional<Cache> cache_;
 
+    // Transfer rates are only set by AccountSet, so they cannot change
+    // while the payment executes. Each is read once and remembered
+    // rather than read again on every pass over the strand.
+    mutable boost::optional<Rate> rateIn_;
+    mutable boost::optional<Rate> rateOut_;
+
 public:
     BookStep (StrandContext const& ctx,
         Issue const& in,
@@ -138,6 +144,22 @@ public:
     TER check(StrandContext const& ctx) const;
 
 protected:
+    // The rate charged on transfers of the book's input or output issue
+    Rate
+    bookRate (ReadView const& v, bool in) const
+    {
+        auto& rate = in ? rateIn_ : rateOut_;
+        if (! rate)
+        {
+            auto const& id = in ? book_.in.account : book_.out.account;
+            if (isXRP (id) || id == strandDst_)
+                rate = parityRate;
+            else
+                rate = transferRate (v, id);
+        }
+        return *rate;
+    }
+
     std::string logStringImpl (char const* name) const
     {
         std::ostringstream ostr;
@@ -238,18 +260,12 @@ public:
         // (the old code does not charge a fee)
         // Calculate amount that goes to the taker and the amount charged the
         // offer owner
-        auto rate = [&](AccountID const& id) {
-            if (isXRP(id) || id == this->strandDst_)
-                return parityRate;
-            return transferRate(v, id);
-        };
-
         auto const trIn =
-            prevStepRedeems ? rate(this->book_.in.account) : parityRate;
+            prevStepRedeems ? this->bookRate(v, true) : parityRate;
         // Always charge the transfer fee, even if the owner is the issuer
         auto const trOut =
             this->ownerPaysTransferFee_
-            ? rate(this->book_.out.account)
+            ? this->bookRate(v, false)
             : parityRate;
 
         Quality const q1{getRate(STAmount(trOut.value), STAmount(trIn.value))};
@@ -483,19 +499,12 @@ BookStep<TIn, TOut, TDerived>::forEachOffer (
     // Charge a fee even if the owner is the same as the issuer
     // (the old code does not charge a fee)
     // Calculate amount that goes to the taker and the amount charged the offer owner
-    auto rate = [this, &sb](AccountID const& id)->std::uint32_t
-    {
-        if (isXRP (id) || id == this->strandDst_)
-            return QUALITY_ONE;
-        return transferRate (sb, id).value;
-    };
-
     std::uint32_t const trIn = prevStepRedeems
-        ? rate (book_.in.account)
+        ? bookRate (sb, true).value
         : QUALITY_ONE;
     // Always charge the transfer fee, even if the owner is the issuer
     std::uint32_t const trOut = ownerPaysTransferFee_
-        ? rate (book_.out.account)
+        ? bookRate (sb, false).value
         : QUALITY_ONE;
 
     typename FlowOfferStream<TIn, TOut>::StepCounter
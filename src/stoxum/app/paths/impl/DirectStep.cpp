@@ -258,6 +258,18 @@ public:
     {
         return logStringImpl ("DirectIPaymentStep");
     }
+
+private:
+    // Reads the quality from the trust line
+    std::uint32_t
+    readQuality (ReadView const& sb, bool qin) const;
+
+    // Line qualities are only set by TrustSet, and a line is only
+    // created or removed by the payment with no qualities set, so they
+    // cannot change while the payment executes. Each is read once and
+    // remembered rather than read again on every pass over the strand.
+    mutable boost::optional<std::uint32_t> qualityIn_;
+    mutable boost::optional<std::uint32_t> qualityOut_;
 };
 
 // Offer crossing DirectStep class (not a payment).
@@ -320,6 +332,15 @@ DirectIPaymentStep::quality (ReadView const& sb,
     if (src_ == dst_)
         return QUALITY_ONE;
 
+    auto& q = qin ? qualityIn_ : qualityOut_;
+    if (! q)
+        q = readQuality (sb, qin);
+    return *q;
+}
+
+std::uint32_t
+DirectIPaymentStep::readQuality (ReadView const& sb, bool qin) const
+{
     auto const sle = sb.read (keylet::line (dst_, src_, currency_));
 
     if (!sle)
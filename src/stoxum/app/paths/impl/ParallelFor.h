@@ -0,0 +1,122 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2017 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+
+#ifndef RIPPLE_APP_PATHS_IMPL_PARALLELFOR_H_INCLUDED
+#define RIPPLE_APP_PATHS_IMPL_PARALLELFOR_H_INCLUDED
+
+#include <stoxum/core/JobQueue.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace ripple {
+namespace path {
+
+/** Call `f(i)` for each `i` in [0, n), with help from the job queue.
+
+    Up to `helpers` jobs of type `type` claim calls along with the
+    calling thread, which returns once every call has finished. The
+    calling thread does all the work if no job runs in time, so this
+    may be used from a job. If a call throws, the first exception is
+    rethrown to the caller once the others are done.
+
+    Calls may run in any order, so each should write only to its own
+    result slot.
+*/
+template <class F>
+void
+parallelFor (JobQueue& jobQueue, JobType type, std::string const& name,
+    std::size_t n, std::size_t helpers, F const& f)
+{
+    if (n == 0)
+        return;
+
+    struct Batch
+    {
+        std::function<void(std::size_t)> f;
+        std::size_t n;
+        std::atomic<std::size_t> next {0};
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::size_t done = 0;
+        std::exception_ptr error;
+    };
+
+    auto batch = std::make_shared<Batch>();
+    batch->f = std::cref (f);
+    batch->n = n;
+
+    // Claims calls until none are left. Jobs that start after
+    // the batch is finished find nothing to do, and never touch `f`.
+    auto work = [](Batch& b)
+    {
+        for (;;)
+        {
+            auto const i = b.next++;
+            if (i >= b.n)
+                return;
+            std::exception_ptr error;
+            try
+            {
+                b.f (i);
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+            std::lock_guard<std::mutex> lock (b.mutex);
+            if (error && ! b.error)
+                b.error = error;
+            if (++b.done == b.n)
+                b.cv.notify_all();
+        }
+    };
+
+    for (std::size_t i = 0; i < std::min (helpers, n - 1); ++i)
+    {
+        if (! jobQueue.addJob (type, name,
+            [batch, work](Job&)
+            {
+                work (*batch);
+            }))
+            break;
+    }
+
+    work (*batch);
+
+    std::unique_lock<std::mutex> lock (batch->mutex);
+    batch->cv.wait (lock, [&batch]
+    {
+        return batch->done == batch->n;
+    });
+    if (batch->error)
+        std::rethrow_exception (batch->error);
+}
+
+} // path
+} // ripple
+
+#endif
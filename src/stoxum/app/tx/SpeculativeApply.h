@@ -0,0 +1,128 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2017 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_TX_SPECULATIVEAPPLY_H_INCLUDED
+#define RIPPLE_TX_SPECULATIVEAPPLY_H_INCLUDED
+
+#include <stoxum/ledger/ApplyView.h>
+#include <stoxum/ledger/OpenView.h>
+#include <stoxum/protocol/STTx.h>
+#include <stoxum/protocol/TER.h>
+#include <stoxum/beast/utility/Journal.h>
+#include <boost/optional.hpp>
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace ripple {
+
+class Application;
+
+/** Applies a batch of transactions to an open view in parallel.
+
+    On construction, every transaction is applied with `ripple::apply`
+    to its own sandbox stacked on the view, using job queue threads.
+    Each sandbox records the keys of the ledger entries it reads,
+    the key ranges it scans and the entries it writes. The view
+    itself is not modified.
+
+    The caller then calls `apply` for each transaction, in the
+    original order. A speculative result is moved into the view only
+    when none of the entries it depends on was written by an earlier
+    transaction of the batch, and the transaction queue would have
+    applied it directly to the view. Otherwise the transaction is
+    applied again, serially, by the function the caller supplies.
+
+    Results are therefore the same as applying the batch serially.
+*/
+class SpeculativeApply
+{
+public:
+    struct Entry
+    {
+        std::shared_ptr<STTx const> tx;
+        ApplyFlags flags;
+    };
+
+    /** Speculatively apply `entries` to sandboxes over `view`.
+
+        Up to `threads` jobs help the calling thread, which
+        blocks until every entry has been processed.
+    */
+    SpeculativeApply (Application& app, OpenView const& view,
+        std::vector<Entry> entries, std::size_t threads,
+            beast::Journal j);
+
+    ~SpeculativeApply();
+
+    SpeculativeApply (SpeculativeApply const&) = delete;
+    SpeculativeApply& operator= (SpeculativeApply const&) = delete;
+
+    /** Apply the entry at `index` to `view`.
+
+        Entries must be applied in order, to the view passed
+        on construction, and nothing else may modify the view
+        in the meantime.
+
+        @param serial Called as `serial(OpenView&)` to apply the
+                      entry when its speculative result cannot
+                      be used. Returns the result of the apply.
+    */
+    template <class Serial>
+    std::pair<TER, bool>
+    apply (std::size_t index, OpenView& view, Serial&& serial)
+    {
+        if (auto const result = commit (index, view))
+            return *result;
+        OpenView layer (batch_view, view);
+        auto const result = serial (layer);
+        record (layer);
+        layer.apply (view);
+        return result;
+    }
+
+    /** Number of speculative results that were committed. */
+    std::size_t
+    committed() const
+    {
+        return committed_;
+    }
+
+private:
+    struct Speculation;
+
+    boost::optional<std::pair<TER, bool>>
+    commit (std::size_t index, OpenView& view);
+
+    void
+    record (OpenView const& layer);
+
+    Application& app_;
+    beast::Journal j_;
+    std::vector<std::unique_ptr<Speculation>> specs_;
+    // Keys written by the transactions applied so far
+    std::set<uint256> dirty_;
+    std::size_t next_ = 0;
+    std::size_t committed_ = 0;
+};
+
+} // ripple
+
+#endif
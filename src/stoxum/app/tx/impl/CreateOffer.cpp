@@ -19,6 +19,7 @@
 
 #include <BeastConfig.h>
 #include <stoxum/app/tx/impl/CreateOffer.h>
+#include <stoxum/app/tx/impl/BookTip.h>
 #include <stoxum/app/ledger/OrderBookDB.h>
 #include <stoxum/app/paths/Flow.h>
 #include <stoxum/ledger/CashDiff.h>
@@ -636,6 +637,29 @@ CreateOffer::takerCross (
     }
 }
 
+// Returns `true` if flow() might take an offer from the book between STM
+// and a currency.  Before using a strand, flow() checks an upper bound of the
+// strand's quality against the threshold.  When the issuer charges no
+// transfer fee, the trust line steps of an offer crossing strand are at
+// parity, so that bound is never better than the quality at the tip of the
+// book.
+static bool
+mayCrossBook (ReadView const& view, Amounts const& takerAmount,
+    Quality const& threshold, beast::Journal j)
+{
+    Sandbox sb (&view, tapNONE);
+    BookTip tip (sb, {takerAmount.in.issue(), takerAmount.out.issue()});
+    if (! tip.step (j))
+        return false;
+
+    AccountID const& issuer = takerAmount.in.native()
+        ? takerAmount.out.getIssuer() : takerAmount.in.getIssuer();
+    if (transferRate (view, issuer) != parityRate)
+        return true;
+
+    return ! (tip.quality() < threshold);
+}
+
 std::pair<TER, Amounts>
 CreateOffer::flowCross (
     PaymentSandbox& psb,
@@ -685,6 +709,18 @@ CreateOffer::flowCross (
         if (txFlags & tfPassive)
             ++threshold;
 
+        // Most offers cross nothing.  An offer between STM and a currency
+        // crosses a single book, so if flow() would not use any offer in
+        // that book, place the offer without building a strand.  flow()
+        // leaves the offer unchanged in that case as well.
+        if (takerAmount.in.native() != takerAmount.out.native() &&
+            ! mayCrossBook (psb, takerAmount, threshold, j_))
+        {
+            JLOG (j_.debug()) <<
+                "Not crossing: no offer in the book meets the threshold.";
+            return { tesSUCCESS, takerAmount };
+        }
+
         // Don't send more than our balance.
         if (sendMax > inStartBalance)
             sendMax = inStartBalance;
@@ -0,0 +1,362 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2017 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <stoxum/app/tx/SpeculativeApply.h>
+#include <stoxum/app/main/Application.h>
+#include <stoxum/app/misc/TxQ.h>
+#include <stoxum/app/tx/apply.h>
+#include <stoxum/core/JobQueue.h>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <mutex>
+
+namespace ripple {
+
+namespace detail {
+
+// Forwards to a base view, remembering what was looked at.
+class ReadSetView
+    : public ReadView
+{
+private:
+    ReadView const& base_;
+
+public:
+    // Keys of entries read or probed
+    std::vector<uint256> mutable keys;
+
+    // Scanned intervals, as (first, last]. An
+    // empty `last` extends to the end of the map.
+    std::vector<std::pair<uint256,
+        boost::optional<uint256>>> mutable ranges;
+
+    // Set when the tx iterated the view or looked
+    // at its tx map, which is not tracked.
+    bool mutable unsafe = false;
+
+    explicit
+    ReadSetView (ReadView const& base)
+        : base_ (base)
+    {
+    }
+
+    LedgerInfo const&
+    info() const override
+    {
+        return base_.info();
+    }
+
+    bool
+    open() const override
+    {
+        return base_.open();
+    }
+
+    Fees const&
+    fees() const override
+    {
+        return base_.fees();
+    }
+
+    Rules const&
+    rules() const override
+    {
+        return base_.rules();
+    }
+
+    bool
+    exists (Keylet const& k) const override
+    {
+        keys.push_back (k.key);
+        return base_.exists (k);
+    }
+
+    boost::optional<key_type>
+    succ (key_type const& key, boost::optional<
+        key_type> const& last = boost::none) const override
+    {
+        auto const result = base_.succ (key, last);
+        ranges.emplace_back (key, result ? result : last);
+        return result;
+    }
+
+    std::shared_ptr<SLE const>
+    read (Keylet const& k) const override
+    {
+        keys.push_back (k.key);
+        return base_.read (k);
+    }
+
+    STAmount
+    balanceHook (AccountID const& account,
+        AccountID const& issuer,
+            STAmount const& amount) const override
+    {
+        return base_.balanceHook (account, issuer, amount);
+    }
+
+    std::uint32_t
+    ownerCountHook (AccountID const& account,
+        std::uint32_t count) const override
+    {
+        return base_.ownerCountHook (account, count);
+    }
+
+    std::unique_ptr<sles_type::iter_base>
+    slesBegin() const override
+    {
+        unsafe = true;
+        return base_.slesBegin();
+    }
+
+    std::unique_ptr<sles_type::iter_base>
+    slesEnd() const override
+    {
+        unsafe = true;
+        return base_.slesEnd();
+    }
+
+    std::unique_ptr<sles_type::iter_base>
+    slesUpperBound (key_type const& key) const override
+    {
+        unsafe = true;
+        return base_.slesUpperBound (key);
+    }
+
+    std::unique_ptr<txs_type::iter_base>
+    txsBegin() const override
+    {
+        unsafe = true;
+        return base_.txsBegin();
+    }
+
+    std::unique_ptr<txs_type::iter_base>
+    txsEnd() const override
+    {
+        unsafe = true;
+        return base_.txsEnd();
+    }
+
+    bool
+    txExists (key_type const& key) const override
+    {
+        unsafe = true;
+        return base_.txExists (key);
+    }
+
+    tx_type
+    txRead (key_type const& key) const override
+    {
+        unsafe = true;
+        return base_.txRead (key);
+    }
+};
+
+// Collects the keys of the entries a view writes.
+class WriteSetView
+    : public TxsRawView
+{
+private:
+    std::vector<uint256>& keys_;
+
+public:
+    explicit
+    WriteSetView (std::vector<uint256>& keys)
+        : keys_ (keys)
+    {
+    }
+
+    void
+    rawErase (std::shared_ptr<SLE> const& sle) override
+    {
+        keys_.push_back (sle->key());
+    }
+
+    void
+    rawInsert (std::shared_ptr<SLE> const& sle) override
+    {
+        keys_.push_back (sle->key());
+    }
+
+    void
+    rawReplace (std::shared_ptr<SLE> const& sle) override
+    {
+        keys_.push_back (sle->key());
+    }
+
+    void
+    rawDestroyXRP (XRPAmount const&) override
+    {
+    }
+
+    void
+    rawTxInsert (ReadView::key_type const&,
+        std::shared_ptr<Serializer const> const&,
+            std::shared_ptr<Serializer const> const&) override
+    {
+    }
+};
+
+} // detail
+
+//------------------------------------------------------------------------------
+
+struct SpeculativeApply::Speculation
+{
+    Entry entry;
+    detail::ReadSetView reads;
+    boost::optional<OpenView> view;
+    std::vector<uint256> writes;
+    std::pair<TER, bool> result { tefEXCEPTION, false };
+    bool valid = false;
+
+    Speculation (Entry&& entry_, ReadView const& base)
+        : entry (std::move(entry_))
+        , reads (base)
+    {
+    }
+};
+
+SpeculativeApply::SpeculativeApply (Application& app,
+    OpenView const& view, std::vector<Entry> entries,
+        std::size_t threads, beast::Journal j)
+    : app_ (app)
+    , j_ (j)
+{
+    specs_.reserve (entries.size());
+    for (auto& entry : entries)
+        specs_.push_back (std::make_unique<Speculation>(
+            std::move(entry), view));
+
+    struct Batch
+    {
+        std::vector<Speculation*> specs;
+        std::atomic<std::size_t> next {0};
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::size_t done = 0;
+    };
+
+    auto batch = std::make_shared<Batch>();
+    for (auto const& spec : specs_)
+        batch->specs.push_back (spec.get());
+
+    // Claims entries until none are left. Helper jobs that start
+    // after the batch is finished find nothing to do.
+    auto work = [&app, j](Batch& b)
+    {
+        for (;;)
+        {
+            auto const i = b.next++;
+            if (i >= b.specs.size())
+                return;
+            auto& s = *b.specs[i];
+            try
+            {
+                s.view.emplace (&s.reads);
+                s.result = ripple::apply (app, *s.view,
+                    *s.entry.tx, s.entry.flags, j);
+                detail::WriteSetView ws (s.writes);
+                s.view->apply (ws);
+                s.valid = ! s.reads.unsafe;
+            }
+            catch (std::exception const&)
+            {
+                // Leave it for the serial pass to report
+                s.valid = false;
+            }
+            std::lock_guard<std::mutex> lock (b.mutex);
+            if (++b.done == b.specs.size())
+                b.cv.notify_all();
+        }
+    };
+
+    auto const helpers = std::min (threads,
+        specs_.empty() ? 0 : specs_.size() - 1);
+    for (std::size_t i = 0; i < helpers; ++i)
+    {
+        if (! app.getJobQueue().addJob (jtSPECULATE,
+            "speculativeApply", [batch, work](Job&)
+            {
+                work (*batch);
+            }))
+            break;
+    }
+
+    work (*batch);
+
+    std::unique_lock<std::mutex> lock (batch->mutex);
+    batch->cv.wait (lock, [&batch]
+    {
+        return batch->done == batch->specs.size();
+    });
+}
+
+SpeculativeApply::~SpeculativeApply() = default;
+
+boost::optional<std::pair<TER, bool>>
+SpeculativeApply::commit (std::size_t index, OpenView& view)
+{
+    assert (index == next_);
+    ++next_;
+    auto const s = std::move (specs_[index]);
+
+    // Results that did not apply are cheap to redo, and the
+    // transaction queue may want to hold the transaction.
+    if (! s->valid || ! s->result.second)
+        return boost::none;
+
+    auto const dirty = [this](uint256 const& key)
+    {
+        return dirty_.count (key) != 0;
+    };
+    if (std::any_of (s->reads.keys.begin(), s->reads.keys.end(), dirty) ||
+        std::any_of (s->writes.begin(), s->writes.end(), dirty))
+        return boost::none;
+    for (auto const& range : s->reads.ranges)
+    {
+        auto const iter = dirty_.upper_bound (range.first);
+        if (iter != dirty_.end() &&
+                (! range.second || *iter <= *range.second))
+            return boost::none;
+    }
+
+    if (! app_.getTxQ().canApplyDirectly (app_, view,
+            *s->entry.tx, s->entry.flags, j_))
+        return boost::none;
+
+    s->view->apply (view);
+    dirty_.insert (s->writes.begin(), s->writes.end());
+    ++committed_;
+    return s->result;
+}
+
+void
+SpeculativeApply::record (OpenView const& layer)
+{
+    std::vector<uint256> writes;
+    detail::WriteSetView ws (writes);
+    layer.apply (ws);
+    dirty_.insert (writes.begin(), writes.end());
+}
+
+} // ripple
@@ -149,6 +149,9 @@ public:
     int                         PATH_SEARCH = 7;
     int                         PATH_SEARCH_FAST = 2;
     int                         PATH_SEARCH_MAX = 10;
+    // Time a path_find subscription may spend raising its first full
+    // search level by level, or zero to search the level at once
+    std::chrono::milliseconds   PATH_SEARCH_BUDGET = 0ms;
 
     // Validation
     boost::optional<std::size_t> VALIDATION_QUORUM;     // validations to consider ledger authoritative
@@ -170,6 +173,9 @@ public:
     // Thread pool configuration
     std::size_t                 WORKERS = 0;
 
+    // Jobs that help apply transaction batches speculatively, 0 disables
+    std::size_t                 PARALLEL_APPLY = 0;
+
     // These override the command line client settings
     boost::optional<boost::asio::ip::address_v4> rpc_ip;
     boost::optional<std::uint16_t> rpc_port;
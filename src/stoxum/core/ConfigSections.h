@@ -49,10 +49,12 @@ struct ConfigSection
 #define SECTION_NETWORK_QUORUM          "network_quorum"
 #define SECTION_NODE_SEED               "node_seed"
 #define SECTION_NODE_SIZE               "node_size"
+#define SECTION_PARALLEL_APPLY          "parallel_apply"
 #define SECTION_PATH_SEARCH_OLD         "path_search_old"
 #define SECTION_PATH_SEARCH             "path_search"
 #define SECTION_PATH_SEARCH_FAST        "path_search_fast"
 #define SECTION_PATH_SEARCH_MAX         "path_search_max"
+#define SECTION_PATH_SEARCH_BUDGET      "path_search_budget"
 #define SECTION_PEER_PRIVATE            "peer_private"
 #define SECTION_PEERS_MAX               "peers_max"
 #define SECTION_RPC_STARTUP             "rpc_startup"
@@ -39,6 +39,7 @@ enum JobType
     // earlier jobs having lower priority than later jobs. If you wish to
     // insert a job at a specific priority, simply add it at the right location.
 
+    jtVERIFY,        // Verify a stored ledger
     jtPACK,          // Make a fetch pack for a peer
     jtPUBOLDLEDGER,  // An old ledger has been accepted
     jtVALIDATION_ut, // A validation from an untrusted source
@@ -49,15 +50,19 @@ enum JobType
     jtCLIENT,        // A websocket command from the client
     jtRPC,           // A websocket command from the client
     jtUPDATE_PF,     // Update pathfinding requests
+    jtPATH_SEARCH,   // Help search for paths in parallel
     jtTRANSACTION,   // A transaction received from the network
     jtBATCH,         // Apply batched transactions
     jtADVANCE,       // Advance validated/acquired ledgers
+    jtSAVE_LEDGERS,  // Write validated ledgers to SQL
     jtPUBLEDGER,     // Publish a fully-accepted ledger
     jtTXN_DATA,      // Fetch a proposed set
     jtWAL,           // Write-ahead logging
+    jtACCOUNT_TX,    // Write out account transaction postings
     jtVALIDATION_t,  // A validation from a trusted source
     jtWRITE,         // Write out hashed objects
     jtACCEPT,        // Accept a consensus ledger
+    jtSPECULATE,     // Speculatively apply a batch of transactions
     jtPROPOSAL_t,    // A proposal from a trusted source
     jtSWEEP,         // Sweep for stale structures
     jtNETOP_CLUSTER, // NetworkOPs cluster peer report
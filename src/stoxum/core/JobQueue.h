@@ -178,6 +178,14 @@ public:
     */
     int getJobCountGE (JobType t) const;
 
+    /** How long jobs at this priority have recently waited to run.
+
+        This is a moving average over the jobs that started. It is
+        zero while no jobs of the type are waiting, so that a backlog
+        that has cleared does not keep appearing busy.
+    */
+    std::chrono::microseconds getQueueWait (JobType t) const;
+
     /** Set the number of thread serving the job queue to precisely this number.
     */
     void setThreadCount (int c, bool const standaloneMode);
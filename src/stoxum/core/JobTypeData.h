@@ -23,6 +23,7 @@
 #include <stoxum/basics/Log.h>
 #include <stoxum/core/JobTypeInfo.h>
 #include <stoxum/beast/insight/Collector.h>
+#include <chrono>
 
 namespace ripple
 {
@@ -48,6 +49,9 @@ public:
     /* And the number we deferred executing because of job limits */
     int deferred;
 
+    /* Smoothed time jobs waited in the queue before running */
+    std::chrono::microseconds queueWait;
+
     /* Notification callbacks */
     beast::insight::Event dequeue;
     beast::insight::Event execute;
@@ -60,6 +64,7 @@ public:
         , waiting (0)
         , running (0)
         , deferred (0)
+        , queueWait (0)
     {
         m_load.setTargetLatency (
             info.getAverageLatency (),
@@ -91,6 +96,12 @@ public:
         return m_load;
     }
 
+    /* Fold the queue wait of a job that is starting into the average */
+    void addQueueWait (std::chrono::microseconds wait)
+    {
+        queueWait = (queueWait * 7 + wait) / 8;
+    }
+
     LoadMonitor::Stats stats ()
     {
         return m_load.getStats ();
@@ -40,6 +40,7 @@ public:
         using namespace std::chrono_literals;
         int maxLimit = std::numeric_limits <int>::max ();
 
+add(    jtVERIFY,        "verifyLedger",            maxLimit, false, 0ms,     0ms);
 add(    jtPACK,          "makeFetchPack",           1,        false, 0ms,     0ms);
 add(    jtPUBOLDLEDGER,  "publishAcqLedger",        2,        false, 10000ms, 15000ms);
 add(    jtVALIDATION_ut, "untrustedValidation",     maxLimit, false, 2000ms,  5000ms);
@@ -50,15 +51,19 @@ add(    jtLEDGER_DATA,   "ledgerData",              2,        false, 0ms,     0m
 add(    jtCLIENT,        "clientCommand",           maxLimit, false, 2000ms,  5000ms);
 add(    jtRPC,           "RPC",                     maxLimit, false, 0ms,     0ms);
 add(    jtUPDATE_PF,     "updatePaths",             maxLimit, false, 0ms,     0ms);
+add(    jtPATH_SEARCH,   "pathSearch",              maxLimit, false, 0ms,     0ms);
 add(    jtTRANSACTION,   "transaction",             maxLimit, false, 250ms,   1000ms);
 add(    jtBATCH,         "batch",                   maxLimit, false, 250ms,   1000ms);
 add(    jtADVANCE,       "advanceLedger",           maxLimit, false, 0ms,     0ms);
+add(    jtSAVE_LEDGERS,  "saveLedgers",             1,        false, 0ms,     0ms);
 add(    jtPUBLEDGER,     "publishNewLedger",        maxLimit, false, 3000ms,  4500ms);
 add(    jtTXN_DATA,      "fetchTxnData",            1,        false, 0ms,     0ms);
 add(    jtWAL,           "writeAhead",              maxLimit, false, 1000ms,  2500ms);
+add(    jtACCOUNT_TX,    "accountTxIndex",          1,        false, 0ms,     0ms);
 add(    jtVALIDATION_t,  "trustedValidation",       maxLimit, false, 500ms,  1500ms);
 add(    jtWRITE,         "writeObjects",            maxLimit, false, 1750ms,  2500ms);
 add(    jtACCEPT,        "acceptLedger",            maxLimit, false, 0ms,     0ms);
+add(    jtSPECULATE,     "speculativeApply",        maxLimit, false, 0ms,     0ms);
 add(    jtPROPOSAL_t,    "trustedProposal",         maxLimit, false, 100ms,   500ms);
 add(    jtSWEEP,         "sweep",                   maxLimit, false, 0ms,     0ms);
 add(    jtNETOP_CLUSTER, "clusterReport",           1,        false, 9999ms,  9999ms);
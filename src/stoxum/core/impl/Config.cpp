@@ -409,6 +409,9 @@ void Config::loadFromString (std::string const& fileContents)
         PATH_SEARCH_FAST    = beast::lexicalCastThrow <int> (strTemp);
     if (getSingleSection (secConfig, SECTION_PATH_SEARCH_MAX, strTemp, j_))
         PATH_SEARCH_MAX     = beast::lexicalCastThrow <int> (strTemp);
+    if (getSingleSection (secConfig, SECTION_PATH_SEARCH_BUDGET, strTemp, j_))
+        PATH_SEARCH_BUDGET  = std::chrono::milliseconds (
+            beast::lexicalCastThrow <std::uint32_t> (strTemp));
 
     if (getSingleSection (secConfig, SECTION_DEBUG_LOGFILE, strTemp, j_))
         DEBUG_LOGFILE       = strTemp;
@@ -416,6 +419,9 @@ void Config::loadFromString (std::string const& fileContents)
     if (getSingleSection (secConfig, SECTION_WORKERS, strTemp, j_))
         WORKERS      = beast::lexicalCastThrow <std::size_t> (strTemp);
 
+    if (getSingleSection (secConfig, SECTION_PARALLEL_APPLY, strTemp, j_))
+        PARALLEL_APPLY = beast::lexicalCastThrow <std::size_t> (strTemp);
+
     // Do not load trusted validator configuration for standalone mode
     if (! RUN_STANDALONE)
     {
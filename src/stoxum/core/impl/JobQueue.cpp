@@ -152,6 +152,19 @@ JobQueue::getJobCountGE (JobType t) const
     return ret;
 }
 
+std::chrono::microseconds
+JobQueue::getQueueWait (JobType t) const
+{
+    std::lock_guard <std::mutex> lock (m_mutex);
+
+    JobDataMap::const_iterator c = m_jobData.find (t);
+
+    if (c == m_jobData.end () || c->second.waiting == 0)
+        return std::chrono::microseconds (0);
+
+    return c->second.queueWait;
+}
+
 void
 JobQueue::setThreadCount (int c, bool const standaloneMode)
 {
@@ -435,6 +448,9 @@ JobQueue::processTask ()
                 std::lock_guard <std::mutex> lock (m_mutex);
                 getNextJob (job);
                 ++m_processCount;
+                getJobTypeData (job.getType ()).addQueueWait (
+                    std::chrono::duration_cast<std::chrono::microseconds> (
+                        start_time - job.queue_time ()));
             }
             type = job.getType();
             JobTypeData& data(getJobTypeData(type));
@@ -23,12 +23,19 @@
 #include <stoxum/basics/chrono.h>
 #include <stoxum/protocol/STLedgerEntry.h>
 #include <stoxum/beast/container/aged_unordered_map.h>
+#include <atomic>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 namespace ripple {
 
-/** Caches SLEs by their digest. */
+/** Caches SLEs by their digest.
+
+    The cache is split into partitions selected by the digest, each
+    with its own lock, so concurrent lookups of different SLEs from
+    path finding, RPC and transaction application rarely contend.
+*/
 class CachedSLEs
 {
 public:
@@ -45,8 +52,11 @@ public:
         Rep, Period> const& timeToLive,
             Stopwatch& clock)
         : timeToLive_ (timeToLive)
-        , map_ (clock)
     {
+        partitions_.reserve(std::size_t{partitionCount});
+        for (std::size_t i = 0; i < partitionCount; ++i)
+            partitions_.emplace_back(
+                std::make_unique<Partition>(clock));
     }
 
     /** Discard expired entries.
@@ -68,29 +78,30 @@ public:
     fetch (digest_type const& digest,
         Handler const& h)
     {
+        auto& p = partition(digest);
         {
             std::lock_guard<
-                std::mutex> lock(mutex_);
+                std::mutex> lock(p.mutex);
             auto iter =
-                map_.find(digest);
-            if (iter != map_.end())
+                p.map.find(digest);
+            if (iter != p.map.end())
             {
                 ++hit_;
-                map_.touch(iter);
+                p.map.touch(iter);
                 return iter->second;
             }
         }
         auto sle = h();
         if (! sle)
             return nullptr;
-        std::lock_guard<
-            std::mutex> lock(mutex_);
         ++miss_;
+        std::lock_guard<
+            std::mutex> lock(p.mutex);
         auto const result =
-            map_.emplace(
+            p.map.emplace(
                 digest, std::move(sle));
         if (! result.second)
-            map_.touch(result.first);
+            p.map.touch(result.first);
         return  result.first->second;
     }
 
@@ -99,13 +110,34 @@ public:
     rate() const;
 
 private:
-    std::size_t hit_ = 0;
-    std::size_t miss_ = 0;
-    std::mutex mutable mutex_;
+    static std::size_t constexpr partitionCount = 16;
+
+    struct Partition
+    {
+        std::mutex mutex;
+        beast::aged_unordered_map <digest_type,
+            value_type, Stopwatch::clock_type,
+                hardened_hash<strong_hash>> map;
+
+        explicit
+        Partition (Stopwatch& clock)
+            : map (clock)
+        {
+        }
+    };
+
+    // The digest is already a hash, so its first byte spreads
+    // entries evenly across the partitions.
+    Partition&
+    partition (digest_type const& digest)
+    {
+        return *partitions_[*digest.begin() % partitionCount];
+    }
+
+    std::atomic<std::size_t> hit_ {0};
+    std::atomic<std::size_t> miss_ {0};
     Stopwatch::duration timeToLive_;
-    beast::aged_unordered_map <digest_type,
-        value_type, Stopwatch::clock_type,
-            hardened_hash<strong_hash>> map_;
+    std::vector<std::unique_ptr<Partition>> partitions_;
 };
 
 } // ripple
@@ -23,10 +23,12 @@
 #include <stoxum/ledger/CachedSLEs.h>
 #include <stoxum/ledger/ReadView.h>
 #include <stoxum/basics/hardened_hash.h>
-#include <map>
+#include <boost/thread/shared_mutex.hpp>
+#include <array>
+#include <atomic>
 #include <memory>
-#include <mutex>
 #include <type_traits>
+#include <unordered_map>
 
 namespace ripple {
 
@@ -36,12 +38,30 @@ class CachedViewImpl
     : public DigestAwareReadView
 {
 private:
+    // Entries are split by key across partitions. Lookups take a
+    // shared lock, so readers of a view only exclude each other while
+    // an entry is being added to the same partition.
+    struct Partition
+    {
+        boost::shared_mutex mutex;
+        std::unordered_map<key_type,
+            std::shared_ptr<SLE const>,
+                hardened_hash<>> map;
+    };
+
+    static std::size_t constexpr partitionCount = 8;
+
     DigestAwareReadView const& base_;
     CachedSLEs& cache_;
-    std::mutex mutable mutex_;
-    std::unordered_map<key_type,
-        std::shared_ptr<SLE const>,
-            hardened_hash<>> mutable map_;
+    std::array<Partition, partitionCount> mutable partitions_;
+    std::atomic<std::size_t> mutable hits_ {0};
+    std::atomic<std::size_t> mutable misses_ {0};
+
+    Partition&
+    partition (key_type const& key) const
+    {
+        return partitions_[*key.begin() % partitionCount];
+    }
 
 public:
     CachedViewImpl() = delete;
@@ -55,6 +75,20 @@ public:
     {
     }
 
+    /** Returns the number of reads answered by this view's map. */
+    std::size_t
+    hits() const
+    {
+        return hits_;
+    }
+
+    /** Returns the number of reads that went to the shared cache. */
+    std::size_t
+    misses() const
+    {
+        return misses_;
+    }
+
     //
     // ReadView
     //
@@ -39,6 +39,14 @@ namespace ripple {
 struct open_ledger_t {};
 extern open_ledger_t const open_ledger;
 
+/** Batch layer construction tag.
+
+    Views constructed with this tag are stacked on
+    an open view and continue its transaction count.
+*/
+struct batch_view_t {};
+extern batch_view_t const batch_view;
+
 //------------------------------------------------------------------------------
 
 /** Writable ledger view that accumulates state and tx changes.
@@ -67,12 +75,19 @@ private:
     detail::RawStateTable items_;
     std::shared_ptr<void const> hold_;
     bool open_ = true;
+    std::size_t baseTxCount_ = 0;
 
 public:
     OpenView() = delete;
     OpenView& operator= (OpenView&&) = delete;
     OpenView& operator= (OpenView const&) = delete;
 
+    /** Move construct.
+
+        Iterators over `sles` obtained from the source
+        are invalidated, since the state table may keep
+        its items inside the object.
+    */
     OpenView (OpenView&&) = default;
 
     /** Construct a shallow copy.
@@ -135,6 +150,23 @@ public:
     OpenView (ReadView const* base,
         std::shared_ptr<void const> hold = nullptr);
 
+    /** Construct a layer over an open view.
+
+        Effects:
+
+            The LedgerInfo and rules are copied
+            from the base.
+
+            The tx count starts from the count in
+            the base, so transactions applied to the
+            layer see the same fee escalation as if
+            they were applied to the base.
+
+        The tx list starts empty and will contain
+        all newly inserted tx.
+    */
+    OpenView (batch_view_t, OpenView const& base);
+
     /** Returns true if this reflects an open ledger. */
     bool
     open() const override
@@ -144,6 +176,9 @@ public:
 
     /** Return the number of tx inserted since creation.
 
+        For a batch layer, this includes the tx
+        in the base view.
+
         This is used to set the "apply ordinal"
         when calculating transaction metadata.
     */
@@ -24,6 +24,7 @@
 #include <stoxum/ledger/Sandbox.h>
 #include <stoxum/ledger/detail/ApplyViewBase.h>
 #include <stoxum/protocol/AccountID.h>
+#include <boost/container/flat_map.hpp>
 #include <map>
 #include <utility>
 
@@ -85,8 +86,10 @@ private:
         AccountID const& a2,
             Currency const& c);
 
-    std::map<Key, Value> credits_;
-    std::map<AccountID, std::uint32_t> ownerCounts_;
+    // Sorted vectors rather than trees: a sandbox holds few entries, and
+    // every balance read searches the tables of each enclosing sandbox.
+    boost::container::flat_map<Key, Value> credits_;
+    boost::container::flat_map<AccountID, std::uint32_t> ownerCounts_;
 };
 
 } // detail
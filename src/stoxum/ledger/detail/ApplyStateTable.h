@@ -20,13 +20,16 @@
 #ifndef RIPPLE_LEDGER_APPLYSTATETABLE_H_INCLUDED
 #define RIPPLE_LEDGER_APPLYSTATETABLE_H_INCLUDED
 
+#include <BeastConfig.h>
 #include <stoxum/ledger/OpenView.h>
 #include <stoxum/ledger/RawView.h>
 #include <stoxum/ledger/ReadView.h>
 #include <stoxum/ledger/TxMeta.h>
+#include <stoxum/ledger/detail/FlatStateMap.h>
 #include <stoxum/protocol/TER.h>
 #include <stoxum/protocol/XRPAmount.h>
 #include <stoxum/beast/utility/Journal.h>
+#include <map>
 #include <memory>
 
 namespace ripple {
@@ -47,8 +50,13 @@ private:
         modify,
     };
 
+#if RIPPLE_FLAT_STATE_TABLES
+    using items_t = FlatStateMap<key_type,
+        std::pair<Action, std::shared_ptr<SLE>>, 16>;
+#else
     using items_t = std::map<key_type,
         std::pair<Action, std::shared_ptr<SLE>>>;
+#endif
 
     items_t items_;
     XRPAmount dropsDestroyed_ = 0;
@@ -0,0 +1,453 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2017 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_LEDGER_FLATSTATEMAP_H_INCLUDED
+#define RIPPLE_LEDGER_FLATSTATEMAP_H_INCLUDED
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ripple {
+namespace detail {
+
+/** Ordered map tuned for the short-lived state tables of the apply path.
+
+    Up to `N` items are kept as a sorted array stored inside the object
+    itself, so a typical transaction touching a handful of ledger entries
+    never allocates for its table and searches contiguous memory. When
+    the array would overflow, the items are moved into a `std::map`
+    using `Allocator`, and the container stays in that mode until it is
+    destroyed.
+
+    The interface is the subset of `std::map` used by the state tables.
+    Unlike `std::map`, any insertion or erasure invalidates iterators
+    while the container is in array mode.
+*/
+template <class Key, class T, std::size_t N,
+    class Allocator = std::allocator<std::pair<Key const, T>>>
+class FlatStateMap
+{
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<Key const, T>;
+    using size_type = std::size_t;
+
+private:
+    using tree_type = std::map<Key, T, std::less<Key>, Allocator>;
+
+    using storage_type = typename std::aligned_storage<
+        sizeof(value_type), alignof(value_type)>::type;
+
+    template <bool IsConst>
+    class iter_impl
+    {
+    private:
+        friend class FlatStateMap;
+
+        using elem_ptr = typename std::conditional<IsConst,
+            typename FlatStateMap::value_type const*,
+                typename FlatStateMap::value_type*>::type;
+
+        using tree_iter = typename std::conditional<IsConst,
+            typename tree_type::const_iterator,
+                typename tree_type::iterator>::type;
+
+        elem_ptr p_ = nullptr;
+        tree_iter it_;
+        bool flat_ = true;
+
+        explicit
+        iter_impl (elem_ptr p)
+            : p_ (p)
+        {
+        }
+
+        explicit
+        iter_impl (tree_iter it)
+            : it_ (it)
+            , flat_ (false)
+        {
+        }
+
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = typename FlatStateMap::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = typename std::conditional<IsConst,
+            value_type const*, value_type*>::type;
+        using reference = typename std::conditional<IsConst,
+            value_type const&, value_type&>::type;
+
+        iter_impl() = default;
+
+        template <bool OtherConst, class = typename
+            std::enable_if<IsConst && ! OtherConst>::type>
+        iter_impl (iter_impl<OtherConst> const& other)
+            : p_ (other.p_)
+            , it_ (other.it_)
+            , flat_ (other.flat_)
+        {
+        }
+
+        reference
+        operator*() const
+        {
+            return flat_ ? *p_ : *it_;
+        }
+
+        pointer
+        operator->() const
+        {
+            return &**this;
+        }
+
+        iter_impl&
+        operator++()
+        {
+            if (flat_)
+                ++p_;
+            else
+                ++it_;
+            return *this;
+        }
+
+        iter_impl
+        operator++(int)
+        {
+            auto const prev = *this;
+            ++*this;
+            return prev;
+        }
+
+        iter_impl&
+        operator--()
+        {
+            if (flat_)
+                --p_;
+            else
+                --it_;
+            return *this;
+        }
+
+        iter_impl
+        operator--(int)
+        {
+            auto const prev = *this;
+            --*this;
+            return prev;
+        }
+
+        friend
+        bool
+        operator== (iter_impl const& lhs, iter_impl const& rhs)
+        {
+            assert (lhs.flat_ == rhs.flat_);
+            return lhs.flat_ ? lhs.p_ == rhs.p_ : lhs.it_ == rhs.it_;
+        }
+
+        friend
+        bool
+        operator!= (iter_impl const& lhs, iter_impl const& rhs)
+        {
+            return ! (lhs == rhs);
+        }
+    };
+
+    storage_type buf_[N];
+    size_type size_ = 0;
+    bool flat_ = true;
+    tree_type tree_;
+
+public:
+    using iterator = iter_impl<false>;
+    using const_iterator = iter_impl<true>;
+
+    FlatStateMap() = default;
+
+    FlatStateMap (FlatStateMap const& other)
+        : flat_ (other.flat_)
+        , tree_ (other.tree_)
+    {
+        for (; size_ < other.size_; ++size_)
+            new (&buf_[size_]) value_type (other.data()[size_]);
+    }
+
+    FlatStateMap (FlatStateMap&& other)
+        : flat_ (other.flat_)
+        , tree_ (std::move(other.tree_))
+    {
+        for (; size_ < other.size_; ++size_)
+            new (&buf_[size_]) value_type (
+                other.data()[size_].first,
+                    std::move(other.data()[size_].second));
+        other.clear_flat();
+    }
+
+    FlatStateMap& operator= (FlatStateMap const&) = delete;
+    FlatStateMap& operator= (FlatStateMap&&) = delete;
+
+    ~FlatStateMap()
+    {
+        clear_flat();
+    }
+
+    bool
+    empty() const
+    {
+        return size() == 0;
+    }
+
+    size_type
+    size() const
+    {
+        return flat_ ? size_ : tree_.size();
+    }
+
+    iterator
+    begin()
+    {
+        return flat_ ? iterator(data()) : iterator(tree_.begin());
+    }
+
+    const_iterator
+    begin() const
+    {
+        return flat_ ? const_iterator(data()) :
+            const_iterator(tree_.begin());
+    }
+
+    iterator
+    end()
+    {
+        return flat_ ? iterator(data() + size_) : iterator(tree_.end());
+    }
+
+    const_iterator
+    end() const
+    {
+        return flat_ ? const_iterator(data() + size_) :
+            const_iterator(tree_.end());
+    }
+
+    iterator
+    lower_bound (key_type const& key)
+    {
+        if (! flat_)
+            return iterator(tree_.lower_bound(key));
+        return iterator(data() + flat_lower_bound(key));
+    }
+
+    const_iterator
+    lower_bound (key_type const& key) const
+    {
+        if (! flat_)
+            return const_iterator(tree_.lower_bound(key));
+        return const_iterator(data() + flat_lower_bound(key));
+    }
+
+    iterator
+    upper_bound (key_type const& key)
+    {
+        if (! flat_)
+            return iterator(tree_.upper_bound(key));
+        return iterator(data() + flat_upper_bound(key));
+    }
+
+    const_iterator
+    upper_bound (key_type const& key) const
+    {
+        if (! flat_)
+            return const_iterator(tree_.upper_bound(key));
+        return const_iterator(data() + flat_upper_bound(key));
+    }
+
+    iterator
+    find (key_type const& key)
+    {
+        if (! flat_)
+            return iterator(tree_.find(key));
+        auto const i = flat_lower_bound(key);
+        if (i == size_ || data()[i].first != key)
+            return end();
+        return iterator(data() + i);
+    }
+
+    const_iterator
+    find (key_type const& key) const
+    {
+        if (! flat_)
+            return const_iterator(tree_.find(key));
+        auto const i = flat_lower_bound(key);
+        if (i == size_ || data()[i].first != key)
+            return end();
+        return const_iterator(data() + i);
+    }
+
+    template <class... Args>
+    std::pair<iterator, bool>
+    emplace (Args&&... args)
+    {
+        if (! flat_)
+        {
+            auto const result = tree_.emplace(
+                std::forward<Args>(args)...);
+            return { iterator(result.first), result.second };
+        }
+        value_type v (std::forward<Args>(args)...);
+        auto const i = flat_lower_bound(v.first);
+        if (i != size_ && data()[i].first == v.first)
+            return { iterator(data() + i), false };
+        if (size_ == N)
+        {
+            to_tree();
+            auto const result = tree_.emplace(std::move(v));
+            return { iterator(result.first), result.second };
+        }
+        return { iterator(flat_insert(i, std::move(v))), true };
+    }
+
+    /** Insert using a hint from lower_bound.
+
+        In array mode the hint is only used when it is exact; the
+        position is otherwise found by binary search.
+    */
+    template <class... Args>
+    iterator
+    emplace_hint (const_iterator hint, Args&&... args)
+    {
+        if (! flat_)
+            return iterator(tree_.emplace_hint(
+                hint.it_, std::forward<Args>(args)...));
+        return emplace(std::forward<Args>(args)...).first;
+    }
+
+    iterator
+    erase (const_iterator pos)
+    {
+        if (! flat_)
+            return iterator(tree_.erase(pos.it_));
+        auto const i = static_cast<size_type>(pos.p_ - data());
+        assert (i < size_);
+        for (auto j = i; j + 1 < size_; ++j)
+            reconstruct(j, std::move(data()[j + 1]));
+        data()[--size_].~value_type();
+        return iterator(data() + i);
+    }
+
+    iterator
+    erase (iterator pos)
+    {
+        return erase(const_iterator(pos));
+    }
+
+private:
+    value_type*
+    data()
+    {
+        return reinterpret_cast<value_type*>(buf_);
+    }
+
+    value_type const*
+    data() const
+    {
+        return reinterpret_cast<value_type const*>(buf_);
+    }
+
+    size_type
+    flat_lower_bound (key_type const& key) const
+    {
+        return std::lower_bound(data(), data() + size_, key,
+            [](value_type const& v, key_type const& k)
+            {
+                return v.first < k;
+            }) - data();
+    }
+
+    size_type
+    flat_upper_bound (key_type const& key) const
+    {
+        return std::upper_bound(data(), data() + size_, key,
+            [](key_type const& k, value_type const& v)
+            {
+                return k < v.first;
+            }) - data();
+    }
+
+    // The key is const, so items are shifted by ending the lifetime
+    // of the destination and constructing a new item in its place.
+    void
+    reconstruct (size_type i, value_type&& v)
+    {
+        data()[i].~value_type();
+        new (&buf_[i]) value_type (v.first, std::move(v.second));
+    }
+
+    value_type*
+    flat_insert (size_type i, value_type&& v)
+    {
+        assert (size_ < N);
+        if (i == size_)
+        {
+            new (&buf_[size_]) value_type (v.first, std::move(v.second));
+            ++size_;
+            return data() + i;
+        }
+        new (&buf_[size_]) value_type (
+            data()[size_ - 1].first,
+                std::move(data()[size_ - 1].second));
+        for (auto j = size_ - 1; j > i; --j)
+            reconstruct(j, std::move(data()[j - 1]));
+        ++size_;
+        reconstruct(i, std::move(v));
+        return data() + i;
+    }
+
+    void
+    to_tree()
+    {
+        assert (flat_ && tree_.empty());
+        for (size_type i = 0; i < size_; ++i)
+            tree_.emplace_hint(tree_.end(), data()[i].first,
+                std::move(data()[i].second));
+        clear_flat();
+        flat_ = false;
+    }
+
+    void
+    clear_flat()
+    {
+        for (size_type i = 0; i < size_; ++i)
+            data()[i].~value_type();
+        size_ = 0;
+    }
+};
+
+} // detail
+} // ripple
+
+#endif
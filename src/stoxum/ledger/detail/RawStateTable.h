@@ -20,8 +20,10 @@
 #ifndef RIPPLE_LEDGER_RAWSTATETABLE_H_INCLUDED
 #define RIPPLE_LEDGER_RAWSTATETABLE_H_INCLUDED
 
+#include <BeastConfig.h>
 #include <stoxum/ledger/RawView.h>
 #include <stoxum/ledger/ReadView.h>
+#include <stoxum/ledger/detail/FlatStateMap.h>
 #include <stoxum/basics/qalloc.h>
 #include <map>
 #include <utility>
@@ -89,10 +91,20 @@ private:
 
     class sles_iter_impl;
 
+    // Iterators into the table, including those held by sles_iter_impl,
+    // are invalidated by any insert or erase, and by moving the table
+    // (and so the OpenView that owns it).
+#if RIPPLE_FLAT_STATE_TABLES
+    using items_t = FlatStateMap<key_type,
+        std::pair<Action, std::shared_ptr<SLE>>, 16,
+        qalloc_type<std::pair<key_type const,
+        std::pair<Action, std::shared_ptr<SLE>>>, false>>;
+#else
     using items_t = std::map<key_type,
         std::pair<Action, std::shared_ptr<SLE>>,
         std::less<key_type>, qalloc_type<std::pair<key_type const,
         std::pair<Action, std::shared_ptr<SLE>>>, false>>;
+#endif
 
     items_t items_;
     XRPAmount dropsDestroyed_ = 0;
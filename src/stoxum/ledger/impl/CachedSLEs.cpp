@@ -28,13 +28,14 @@ CachedSLEs::expire()
 {
     std::vector<
         std::shared_ptr<void const>> trash;
+    for (auto& p : partitions_)
     {
         auto const expireTime =
-            map_.clock().now() - timeToLive_;
+            p->map.clock().now() - timeToLive_;
         std::lock_guard<
-            std::mutex> lock(mutex_);
-        for (auto iter = map_.chronological.begin();
-            iter != map_.chronological.end(); ++iter)
+            std::mutex> lock(p->mutex);
+        for (auto iter = p->map.chronological.begin();
+            iter != p->map.chronological.end(); ++iter)
         {
             if (iter.when() > expireTime)
                 break;
@@ -42,7 +43,7 @@ CachedSLEs::expire()
             {
                 trash.emplace_back(
                     std::move(iter->second));
-                iter = map_.erase(iter);
+                iter = p->map.erase(iter);
             }
         }
     }
@@ -51,12 +52,11 @@ CachedSLEs::expire()
 double
 CachedSLEs::rate() const
 {
-    std::lock_guard<
-        std::mutex> lock(mutex_);
-    auto const tot = hit_ + miss_;
+    std::size_t const hit = hit_;
+    auto const tot = hit + miss_;
     if (tot == 0)
         return 0;
-    return double(hit_) / tot;
+    return double(hit) / tot;
 }
 
 } // ripple
@@ -34,30 +34,33 @@ CachedViewImpl::exists (Keylet const& k) const
 std::shared_ptr<SLE const>
 CachedViewImpl::read (Keylet const& k) const
 {
+    auto& p = partition(k.key);
     {
-        std::lock_guard<
-            std::mutex> lock(mutex_);
-        auto const iter = map_.find(k.key);
-        if (iter != map_.end())
+        boost::shared_lock<
+            boost::shared_mutex> lock(p.mutex);
+        auto const iter = p.map.find(k.key);
+        if (iter != p.map.end())
         {
+            ++hits_;
             if (! k.check(*iter->second))
                 return nullptr;
             return iter->second;
         }
     }
+    ++misses_;
     auto const digest =
         base_.digest(k.key);
     if (! digest)
         return nullptr;
     auto sle = cache_.fetch(*digest,
         [&]() { return base_.read(k); });
-    std::lock_guard<
-        std::mutex> lock(mutex_);
+    boost::unique_lock<
+        boost::shared_mutex> lock(p.mutex);
     auto const iter =
-        map_.find(k.key);
-    if (iter == map_.end())
+        p.map.find(k.key);
+    if (iter == p.map.end())
     {
-        map_.emplace(k.key, sle);
+        p.map.emplace(k.key, sle);
         return sle;
     }
     if (! k.check(*iter->second))
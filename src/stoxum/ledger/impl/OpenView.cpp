@@ -25,6 +25,8 @@ namespace ripple {
 
 open_ledger_t const open_ledger {};
 
+batch_view_t const batch_view {};
+
 class OpenView::txs_iter_impl
     : public txs_type::iter_base
 {
@@ -111,10 +113,19 @@ OpenView::OpenView (ReadView const* base,
 {
 }
 
+OpenView::OpenView (batch_view_t, OpenView const& base)
+    : rules_ (base.rules_)
+    , info_ (base.info_)
+    , base_ (&base)
+    , open_ (base.open_)
+    , baseTxCount_ (base.txCount())
+{
+}
+
 std::size_t
 OpenView::txCount() const
 {
-    return txs_.size();
+    return baseTxCount_ + txs_.size();
 }
 
 void
@@ -52,8 +52,8 @@ DeferredCredits::credit (AccountID const& sender,
     assert (!amount.negative());
 
     auto const k = makeKey (sender, receiver, amount.getCurrency ());
-    auto i = credits_.find (k);
-    if (i == credits_.end ())
+    auto i = credits_.lower_bound (k);
+    if (i == credits_.end () || i->first != k)
     {
         Value v;
 
@@ -70,7 +70,7 @@ DeferredCredits::credit (AccountID const& sender,
             v.lowAcctOrigBalance = -preCreditSenderBalance;
         }
 
-        credits_[k] = v;
+        credits_.emplace_hint (i, k, v);
     }
     else
     {
@@ -136,6 +136,14 @@ DeferredCredits::adjustments (AccountID const& main,
 void DeferredCredits::apply(
     DeferredCredits& to)
 {
+    // A sandbox applied to one that recorded nothing needs no merge
+    if (to.credits_.empty () && to.ownerCounts_.empty ())
+    {
+        to.credits_ = credits_;
+        to.ownerCounts_ = ownerCounts_;
+        return;
+    }
+
     for (auto const& i : credits_)
     {
         auto r = to.credits_.emplace (i);
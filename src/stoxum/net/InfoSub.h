@@ -26,7 +26,9 @@
 #include <stoxum/resource/Consumer.h>
 #include <stoxum/protocol/Book.h>
 #include <stoxum/core/Stoppable.h>
+#include <memory>
 #include <mutex>
+#include <string>
 
 namespace ripple {
 
@@ -52,6 +54,40 @@ public:
 
     using Consumer = Resource::Consumer;
 
+    /** A JSON message published to many subscribers.
+
+        The compact text of the message is rendered the first time it
+        is asked for, and the same buffer is then shared by every
+        subscriber that sends text. The message refers to the JSON
+        without copying it, and may only be used by one thread.
+    */
+    class Message
+    {
+    private:
+        Json::Value const& json_;
+        std::shared_ptr<std::string const> mutable text_;
+
+    public:
+        explicit
+        Message (Json::Value const& json)
+            : json_ (json)
+        {
+        }
+
+        Message (Message const&) = delete;
+        Message& operator= (Message const&) = delete;
+
+        Json::Value const&
+        json () const
+        {
+            return json_;
+        }
+
+        /** The compact JSON text, followed by a newline. */
+        std::shared_ptr<std::string const> const&
+        text () const;
+    };
+
 public:
     /** Abstracts the source of subscription data.
     */
@@ -128,6 +164,12 @@ public:
 
     virtual void send (Json::Value const& jvObj, bool broadcast) = 0;
 
+    /** Send a message that is shared with other subscribers.
+
+        By default, the message is sent as JSON.
+    */
+    virtual void send (Message const& msg, bool broadcast);
+
     std::uint64_t getSeq ();
 
     void onSendEmpty ();
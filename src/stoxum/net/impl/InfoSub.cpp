@@ -19,6 +19,7 @@
 
 #include <BeastConfig.h>
 #include <stoxum/net/InfoSub.h>
+#include <stoxum/json/json_writer.h>
 #include <atomic>
 
 namespace ripple {
@@ -43,6 +44,24 @@ InfoSub::Source::Source (char const* name, Stoppable& parent)
 
 //------------------------------------------------------------------------------
 
+std::shared_ptr<std::string const> const&
+InfoSub::Message::text () const
+{
+    if (! text_)
+    {
+        auto text = std::make_shared<std::string> ();
+        Json::stream (json_,
+            [&text](void const* data, std::size_t n)
+            {
+                text->append (static_cast<char const*> (data), n);
+            });
+        text_ = std::move (text);
+    }
+    return text_;
+}
+
+//------------------------------------------------------------------------------
+
 InfoSub::InfoSub(Source& source)
     : m_source(source)
     , mSeq(assign_id())
@@ -82,6 +101,11 @@ Resource::Consumer& InfoSub::getConsumer()
     return m_consumer;
 }
 
+void InfoSub::send (Message const& msg, bool broadcast)
+{
+    send (msg.json (), broadcast);
+}
+
 std::uint64_t InfoSub::getSeq ()
 {
     return mSeq;
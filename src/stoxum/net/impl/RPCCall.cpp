@@ -648,6 +648,24 @@ private:
         return jvRequest;
     }
 
+    // ledger_verify <min_ledger> <max_ledger> [replay]
+    Json::Value parseLedgerVerify (Json::Value const& jvParams)
+    {
+        Json::Value jvRequest{Json::objectValue};
+
+        jvRequest[jss::min_ledger] = jvParams[0u].asUInt ();
+        jvRequest[jss::max_ledger] = jvParams[1u].asUInt ();
+
+        if (jvParams.size () == 3)
+        {
+            if (jvParams[2u].asString () != "replay")
+                return rpcError (rpcINVALID_PARAMS);
+            jvRequest[jss::replay] = true;
+        }
+
+        return jvRequest;
+    }
+
     // log_level:                           Get log levels
     // log_level <severity>:                Set master log level to the specified severity
     // log_level <partition> <severity>:    Set specified partition to specified severity
@@ -1102,6 +1120,7 @@ public:
     //      {   "ledger_entry",         &RPCParser::parseLedgerEntry,          -1, -1   },
             {   "ledger_header",        &RPCParser::parseLedgerId,              1,  1   },
             {   "ledger_request",       &RPCParser::parseLedgerId,              1,  1   },
+            {   "ledger_verify",        &RPCParser::parseLedgerVerify,          2,  3   },
             {   "log_level",            &RPCParser::parseLogLevel,              0,  2   },
             {   "logrotate",            &RPCParser::parseAsIs,                  0,  0   },
             {   "owner_info",           &RPCParser::parseAccountItems,          1,  2   },
@@ -46,6 +46,7 @@ JSS ( LastLedgerSequence );         // in: TransactionSign; field
 JSS ( LimitAmount );                // field.
 JSS ( OfferSequence );              // field.
 JSS ( Paths );                      // in/out: TransactionSign
+JSS ( RPC_hit_rate );               // out: GetCounts
 JSS ( TransferRate );               // in: TransferRate
 JSS ( historical_perminute );       // historical_perminute
 JSS ( SLE_hit_rate );               // out: GetCounts
@@ -105,6 +106,7 @@ JSS ( channel_id );                 // out: AccountChannels
 JSS ( channels );                   // out: AccountChannels
 JSS ( check );                      // in: AccountObjects
 JSS ( check_nodes );                // in: LedgerCleaner
+JSS ( checked );                    // out: LedgerVerify
 JSS ( clear );                      // in/out: FetchInfo
 JSS ( close_flags );                // out: LedgerToJson
 JSS ( close_time );                 // in: Application, out: NetworkOPs,
@@ -161,6 +163,7 @@ JSS ( error );                      // out: error
 JSS ( error_code );                 // out: error
 JSS ( error_exception );            // out: Submit
 JSS ( error_message );              // out: error
+JSS ( errors );                     // out: LedgerVerify
 JSS ( escrow );                     // in: LedgerEntry
 JSS ( expand );                     // in: handler/Ledger
 JSS ( expected_ledger_size );       // out: TxQ
@@ -168,6 +171,7 @@ JSS ( expiration );                 // out: AccountOffers, AccountChannels,
                                     //      ValidatorList
 JSS ( fail_hard );                  // in: Sign, Submit
 JSS ( failed );                     // out: InboundLedger
+JSS ( failures );                   // out: LedgerVerify
 JSS ( feature );                    // in: Feature
 JSS ( features );                   // out: Feature
 JSS ( fee );                        // out: NetworkOPs, Peers
@@ -358,6 +362,7 @@ JSS ( reference_level );            // out: TxQ
 JSS ( refresh_interval_min );       // out: ValidatorSites
 JSS ( regular_seed );               // in/out: LedgerEntry
 JSS ( remote );                     // out: Logic.h
+JSS ( replay );                     // in/out: LedgerVerify
 JSS ( request );                    // RPC
 JSS ( reserve_base );               // out: NetworkOPs
 JSS ( reserve_base_xrp );           // out: NetworkOPs
@@ -365,10 +370,12 @@ JSS ( reserve_inc );                // out: NetworkOPs
 JSS ( reserve_inc_xrp );            // out: NetworkOPs
 JSS ( response );                   // websocket
 JSS ( result );                     // RPC
+JSS ( retry_after );                // out: RPC
 JSS ( ripple_lines );               // out: NetworkOPs
 JSS ( ripple_state );               // in: LedgerEntr
 JSS ( ripplerpc );                  // ripple RPC version
 JSS ( role );                       // out: Ping.cpp
+JSS ( rpc_methods );                // out: get_counts
 JSS ( rt_accounts );                // in: Subscribe, Unsubscribe
 JSS ( sanity );                     // out: PeerImp
 JSS ( search_depth );               // in: RipplePathFind
@@ -0,0 +1,94 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2017 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+#ifndef RIPPLE_RPC_BINARYRPC_H_INCLUDED
+#define RIPPLE_RPC_BINARYRPC_H_INCLUDED
+
+#include <stoxum/protocol/Serializer.h>
+#include <stoxum/rpc/Context.h>
+#include <stoxum/rpc/Status.h>
+
+namespace ripple {
+namespace RPC {
+
+/*  Binary responses
+
+    A client that sends a JSON-RPC request over HTTP with the header
+
+        Accept: application/x-stoxum-binary
+
+    receives the result of `account_tx`, `ledger_data` or `book_offers`
+    as canonical binary instead of JSON, so that the server never builds
+    the JSON tree for the large replies these commands produce. The
+    request itself is still JSON. Batch requests are not supported.
+
+    Every response starts with
+
+        u8      format version, currently 1
+        u32     error code, 0 on success
+
+    An error is followed by the error token and message, each as a
+    variable length field. On success the command's result follows:
+
+    ledger_data
+        u32     ledger sequence
+        u256    ledger hash
+        u32     entry count
+        entries, each a u256 key then the entry as a variable length field
+        u8      1 if a u256 marker follows, otherwise 0
+
+    account_tx
+        u32     first ledger searched
+        u32     last ledger searched
+        u32     transaction count
+        transactions, each a u32 ledger sequence then the transaction
+            and its metadata as variable length fields
+        u8      1 if a u32 ledger and u32 sequence marker follow,
+                otherwise 0
+
+    book_offers
+        u32     ledger sequence
+        u32     offer count
+        offers in quality order, each as a variable length field.
+            Unfunded offers are included and owner funds are not
+            computed, unlike the JSON response.
+
+    Integers are big-endian and variable length fields use the same
+    length prefix as serialized ledger objects. Markers are passed back
+    in the JSON request as they would be for a JSON response.
+*/
+
+/** The media type that selects binary responses. */
+char const* const binaryMediaType = "application/x-stoxum-binary";
+
+/** The version written at the start of every binary response. */
+std::uint8_t constexpr binaryFormatVersion = 1;
+
+/** Execute an RPC command and write the results in the binary format.
+
+    If the command has no binary form the response carries
+    rpcUNKNOWN_COMMAND.
+*/
+Status doBinaryCommand (RPC::Context&, Serializer&);
+
+} // RPC
+} // ripple
+
+#endif
@@ -0,0 +1,90 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2017 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+
+#ifndef RIPPLE_RPC_RPCADMISSION_H_INCLUDED
+#define RIPPLE_RPC_RPCADMISSION_H_INCLUDED
+
+#include <stoxum/beast/insight/Collector.h>
+#include <stoxum/beast/utility/Journal.h>
+#include <stoxum/core/Config.h>
+#include <stoxum/rpc/Role.h>
+#include <boost/optional.hpp>
+#include <chrono>
+
+namespace ripple {
+
+class JobQueue;
+
+/** Decides whether the server has room for another RPC call.
+
+    The time that client jobs have recently waited in the job queue
+    is compared with a target. Once the wait is over the target,
+    calls to heavy commands from clients that are not unlimited are
+    refused, and once it is several times the target, every call from
+    such clients is. Refused clients are told how long to wait before
+    they try again.
+*/
+class RPCAdmission
+{
+public:
+    struct Setup
+    {
+        // Queue wait above which heavy calls are refused, zero admits all
+        std::chrono::milliseconds targetWait {500};
+
+        // Multiple of the target above which all calls are refused
+        int refuseAllFactor = 4;
+    };
+
+    RPCAdmission (Setup const& setup, JobQueue& jobQueue,
+        beast::insight::Collector::ptr const& collector,
+            beast::Journal journal);
+
+    RPCAdmission (RPCAdmission const&) = delete;
+    RPCAdmission& operator= (RPCAdmission const&) = delete;
+
+    /** Return when the client should retry, if the call is refused.
+
+        @param heavy `true` if the command may walk many ledger entries.
+    */
+    boost::optional<std::chrono::seconds>
+    check (Role role, bool heavy);
+
+    /** The decision made by check for a given queue wait. */
+    static
+    boost::optional<std::chrono::seconds>
+    decide (Setup const& setup, std::chrono::microseconds wait,
+        Role role, bool heavy);
+
+private:
+    Setup const setup_;
+    JobQueue& jobQueue_;
+    beast::Journal j_;
+
+    beast::insight::Meter refused_;
+};
+
+RPCAdmission::Setup
+setup_RPCAdmission (Config const& config);
+
+} // ripple
+
+#endif
@@ -21,6 +21,7 @@
 #define RIPPLE_RPC_RPCHANDLER_H_INCLUDED
 
 #include <stoxum/core/Config.h>
+#include <stoxum/json/Object.h>
 #include <stoxum/net/InfoSub.h>
 #include <stoxum/rpc/Context.h>
 #include <stoxum/rpc/Status.h>
@@ -33,6 +34,16 @@ struct Context;
 /** Execute an RPC command and store the results in a Json::Value. */
 Status doCommand (RPC::Context&, Json::Value&);
 
+/** Execute an RPC command and write the results to a Json::Object.
+
+    Commands for which streamsResult() is true write their results as
+    they are produced. Others are run as usual and their results copied.
+*/
+Status doCommand (RPC::Context&, Json::Object&);
+
+/** Return `true` if the method writes its results as it goes. */
+bool streamsResult (std::string const& method);
+
 Role roleRequired (std::string const& method );
 
 } // RPC
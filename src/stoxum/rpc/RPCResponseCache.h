@@ -0,0 +1,128 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2017 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#ifndef RIPPLE_RPC_RPCRESPONSECACHE_H_INCLUDED
+#define RIPPLE_RPC_RPCRESPONSECACHE_H_INCLUDED
+
+#include <stoxum/basics/base_uint.h>
+#include <stoxum/basics/chrono.h>
+#include <stoxum/basics/TaggedCache.h>
+#include <stoxum/beast/insight/Collector.h>
+#include <stoxum/beast/utility/Journal.h>
+#include <stoxum/core/Config.h>
+#include <stoxum/json/json_value.h>
+#include <boost/optional.hpp>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace ripple {
+
+namespace RPC { struct Context; }
+
+/** Responses to RPC requests that can not change.
+
+    A request for a validated ledger, such as account_info with a
+    numeric ledger_index, always gets the same response. Those
+    responses are kept, keyed by the request and the hash of the
+    ledger it was answered from, so that popular queries do not walk
+    the ledger and build their result again.
+
+    Only responses that say they came from a validated ledger are
+    kept, and only when they are small.
+*/
+class RPCResponseCache
+{
+public:
+    struct Setup
+    {
+        // Responses kept, zero disables the cache
+        int size = 4096;
+
+        // How long a response is kept after it was last used
+        std::chrono::seconds age {300};
+
+        // Larger responses are not kept
+        std::size_t maxEntryBytes = 64 * 1024;
+    };
+
+    /** A request whose response may be kept. */
+    struct Request
+    {
+        uint256 key;
+
+        // The ledger named by the request, zero if it names none
+        uint256 ledgerHash;
+    };
+
+    RPCResponseCache (Setup const& setup, Stopwatch& clock,
+        beast::insight::Collector::ptr const& collector,
+            beast::Journal journal);
+
+    RPCResponseCache (RPCResponseCache const&) = delete;
+    RPCResponseCache& operator= (RPCResponseCache const&) = delete;
+
+    /** Return the request if its response may be kept.
+
+        The ledger the request names is resolved to its hash, so
+        requests for "validated" share the responses of requests for
+        that ledger by index or hash.
+    */
+    boost::optional<Request>
+    request (RPC::Context const& context, std::string const& method) const;
+
+    /** Return the kept response to a request, if there is one. */
+    std::shared_ptr<Json::Value const>
+    fetch (Request const& request);
+
+    /** Keep the response to a request, if it can not change. */
+    void
+    insert (Request const& request, Json::Value const& result);
+
+    /** Remove responses that have not been used recently. */
+    void
+    sweep ()
+    {
+        cache_.sweep();
+    }
+
+    float
+    getHitRate ()
+    {
+        return cache_.getHitRate();
+    }
+
+    int
+    getCacheSize () const
+    {
+        return cache_.getCacheSize();
+    }
+
+private:
+    Setup const setup_;
+    TaggedCache<uint256, Json::Value> cache_;
+};
+
+RPCResponseCache::Setup
+setup_RPCResponseCache (Config const& config);
+
+} // ripple
+
+#endif
@@ -0,0 +1,118 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2017 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+#ifndef RIPPLE_RPC_RPCSTATS_H_INCLUDED
+#define RIPPLE_RPC_RPCSTATS_H_INCLUDED
+
+#include <stoxum/beast/insight/Collector.h>
+#include <stoxum/beast/utility/Journal.h>
+#include <stoxum/core/Config.h>
+#include <stoxum/json/json_value.h>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace ripple {
+
+/** Latency and traffic statistics for each RPC method.
+
+    Each method keeps a histogram of how long its calls took, with
+    buckets that double in width, from which the percentiles reported
+    by get_counts are estimated. Calls slower than a configured limit
+    are logged with their secrets removed.
+*/
+class RPCStats
+{
+public:
+    struct Setup
+    {
+        // Calls at least this slow are logged, zero logs none
+        std::chrono::milliseconds slowRequest {1000};
+    };
+
+    // Histogram buckets; bucket i holds calls under 2^(i+1) microseconds
+    static std::size_t constexpr buckets = 32;
+
+    RPCStats (Setup const& setup,
+        beast::insight::Collector::ptr const& collector,
+            beast::Journal journal);
+
+    RPCStats (RPCStats const&) = delete;
+    RPCStats& operator= (RPCStats const&) = delete;
+
+    /** Record a call to a method. */
+    void
+    onCall (std::string const& method, Json::Value const& params,
+        std::chrono::microseconds elapsed, bool failed);
+
+    /** Record the size of a request and its response.
+
+        Methods that have not been called are ignored, so that
+        requests for unknown methods do not add entries.
+    */
+    void
+    onTraffic (std::string const& method,
+        std::size_t requestBytes, std::size_t responseBytes);
+
+    /** Return the statistics of every method that was called. */
+    Json::Value
+    getJson () const;
+
+    /** Return a copy of the request with its secrets removed. */
+    static
+    Json::Value
+    redact (Json::Value const& params);
+
+private:
+    struct Method
+    {
+        std::uint64_t calls = 0;
+        std::uint64_t failures = 0;
+        std::uint64_t requestBytes = 0;
+        std::uint64_t responseBytes = 0;
+        std::chrono::microseconds total {0};
+        std::chrono::microseconds max {0};
+        std::array<std::uint64_t, buckets> histogram {};
+
+        beast::insight::Event time;
+        beast::insight::Meter bytes;
+
+        // The elapsed time below which a fraction `q` of calls fall
+        std::chrono::microseconds
+        percentile (double q) const;
+    };
+
+    Setup const setup_;
+    beast::insight::Collector::ptr collector_;
+    beast::Journal j_;
+
+    std::mutex mutable mutex_;
+    std::map<std::string, Method> methods_;
+};
+
+RPCStats::Setup
+setup_RPCStats (Config const& config);
+
+} // ripple
+
+#endif
@@ -23,6 +23,7 @@
 #include <stoxum/app/misc/NetworkOPs.h>
 #include <stoxum/app/misc/Transaction.h>
 #include <stoxum/json/json_value.h>
+#include <stoxum/json/Object.h>
 #include <stoxum/ledger/ReadView.h>
 #include <stoxum/net/RPCErr.h>
 #include <stoxum/protocol/ErrorCodes.h>
@@ -35,27 +36,19 @@
 
 namespace ripple {
 
-// {
-//   account: account,
-//   ledger_index_min: ledger_index  // optional, defaults to earliest
-//   ledger_index_max: ledger_index, // optional, defaults to latest
-//   binary: boolean,                // optional, defaults to false
-//   forward: boolean,               // optional, defaults to false
-//   limit: integer,                 // optional
-//   marker: opaque                  // optional, resume previous query
-// }
-Json::Value doAccountTx (RPC::Context& context)
+Json::Value doAccountTxOld (RPC::Context& context);
+
+namespace {
+
+// Reads the account and the range of ledgers to search, returning
+// an error if there is one.
+boost::optional<Json::Value>
+readAccountTx (RPC::Context& context, AccountID& account,
+    std::uint32_t& uLedgerMin, std::uint32_t& uLedgerMax,
+        std::uint32_t& uValidatedMin, std::uint32_t& uValidatedMax)
 {
     auto& params = context.params;
 
-    int limit = params.isMember (jss::limit) ?
-            params[jss::limit].asUInt () : -1;
-    bool bBinary = params.isMember (jss::binary) && params[jss::binary].asBool ();
-    bool bForward = params.isMember (jss::forward) && params[jss::forward].asBool ();
-    std::uint32_t   uLedgerMin;
-    std::uint32_t   uLedgerMax;
-    std::uint32_t   uValidatedMin;
-    std::uint32_t   uValidatedMax;
     bool bValidated = context.ledgerMaster.getValidatedRange (
         uValidatedMin, uValidatedMax);
 
@@ -68,10 +61,11 @@ Json::Value doAccountTx (RPC::Context& context)
     if (!params.isMember (jss::account))
         return rpcError (rpcINVALID_PARAMS);
 
-    auto const account = parseBase58<AccountID>(
+    auto const parsed = parseBase58<AccountID>(
         params[jss::account].asString());
-    if (! account)
+    if (! parsed)
         return rpcError (rpcACT_MALFORMED);
+    account = *parsed;
 
     context.loadType = Resource::feeMediumBurdenRPC;
 
@@ -115,51 +109,59 @@ Json::Value doAccountTx (RPC::Context& context)
         uLedgerMax = uValidatedMax;
     }
 
+    return boost::none;
+}
+
+// Writes the transactions found, then the query that found them
+template <class Object>
+void
+writeAccountTx (RPC::Context& context, Object& ret, AccountID const& account,
+    std::uint32_t uLedgerMin, std::uint32_t uLedgerMax,
+        std::uint32_t uValidatedMin, std::uint32_t uValidatedMax)
+{
+    auto& params = context.params;
+
+    int limit = params.isMember (jss::limit) ?
+            params[jss::limit].asUInt () : -1;
+    bool bBinary = params.isMember (jss::binary) && params[jss::binary].asBool ();
+    bool bForward = params.isMember (jss::forward) && params[jss::forward].asBool ();
+
     Json::Value resumeToken;
 
     if (params.isMember(jss::marker))
          resumeToken = params[jss::marker];
 
-#ifndef BEAST_DEBUG
-
-    try
+    ret[jss::account] = context.app.accountIDCache().toBase58(account);
     {
-#endif
-        Json::Value ret (Json::objectValue);
-
-        ret[jss::account] = context.app.accountIDCache().toBase58(*account);
-        Json::Value& jvTxns = (ret[jss::transactions] = Json::arrayValue);
+        auto&& jvTxns = Json::setArray (ret, jss::transactions);
 
         if (bBinary)
         {
-            auto txns = context.netOps.getTxsAccountB (
-                *account, uLedgerMin, uLedgerMax, bForward, resumeToken, limit,
-                isUnlimited (context.role));
-
-            for (auto& it: txns)
-            {
-                Json::Value& jvObj = jvTxns.append (Json::objectValue);
-
-                jvObj[jss::tx_blob] = std::get<0> (it);
-                jvObj[jss::meta] = std::get<1> (it);
-
-                std::uint32_t uLedgerIndex = std::get<2> (it);
+            context.netOps.forEachTxAccount (
+                account, uLedgerMin, uLedgerMax, bForward, resumeToken, limit,
+                isUnlimited (context.role),
+                [&](std::uint32_t uLedgerIndex, Blob const& rawTxn,
+                    Blob const& rawMeta)
+                {
+                    auto&& jvObj = Json::appendObject (jvTxns);
 
-                jvObj[jss::ledger_index] = uLedgerIndex;
-                jvObj[jss::validated] = bValidated &&
-                    uValidatedMin <= uLedgerIndex &&
-                    uValidatedMax >= uLedgerIndex;
-            }
+                    jvObj[jss::tx_blob] = strHex (rawTxn);
+                    jvObj[jss::meta] = strHex (rawMeta);
+                    jvObj[jss::ledger_index] = uLedgerIndex;
+                    jvObj[jss::validated] =
+                        uValidatedMin <= uLedgerIndex &&
+                        uValidatedMax >= uLedgerIndex;
+                });
         }
         else
         {
             auto txns = context.netOps.getTxsAccount (
-                *account, uLedgerMin, uLedgerMax, bForward, resumeToken, limit,
+                account, uLedgerMin, uLedgerMax, bForward, resumeToken, limit,
                 isUnlimited (context.role));
 
             for (auto& it: txns)
             {
-                Json::Value& jvObj = jvTxns.append (Json::objectValue);
+                auto&& jvObj = Json::appendObject (jvTxns);
 
                 if (it.first)
                     jvObj[jss::tx] = it.first->getJson (1);
@@ -172,22 +174,55 @@ Json::Value doAccountTx (RPC::Context& context)
 
                     std::uint32_t uLedgerIndex = it.second->getLgrSeq ();
 
-                    jvObj[jss::validated] = bValidated &&
+                    jvObj[jss::validated] =
                         uValidatedMin <= uLedgerIndex &&
                         uValidatedMax >= uLedgerIndex;
                 }
 
             }
         }
+    }
+
+    //Add information about the original query
+    ret[jss::ledger_index_min] = uLedgerMin;
+    ret[jss::ledger_index_max] = uLedgerMax;
+    if (params.isMember (jss::limit))
+        ret[jss::limit]        = limit;
+    if (resumeToken)
+        ret[jss::marker] = resumeToken;
+}
+
+} // namespace
+
+// {
+//   account: account,
+//   ledger_index_min: ledger_index  // optional, defaults to earliest
+//   ledger_index_max: ledger_index, // optional, defaults to latest
+//   binary: boolean,                // optional, defaults to false
+//   forward: boolean,               // optional, defaults to false
+//   limit: integer,                 // optional
+//   marker: opaque                  // optional, resume previous query
+// }
+Json::Value doAccountTx (RPC::Context& context)
+{
+    std::uint32_t   uLedgerMin;
+    std::uint32_t   uLedgerMax;
+    std::uint32_t   uValidatedMin;
+    std::uint32_t   uValidatedMax;
+    AccountID       account;
 
-        //Add information about the original query
-        ret[jss::ledger_index_min] = uLedgerMin;
-        ret[jss::ledger_index_max] = uLedgerMax;
-        if (params.isMember (jss::limit))
-            ret[jss::limit]        = limit;
-        if (resumeToken)
-            ret[jss::marker] = resumeToken;
+    if (auto err = readAccountTx (context, account,
+            uLedgerMin, uLedgerMax, uValidatedMin, uValidatedMax))
+        return *err;
 
+#ifndef BEAST_DEBUG
+
+    try
+    {
+#endif
+        Json::Value ret (Json::objectValue);
+        writeAccountTx (context, ret, account,
+            uLedgerMin, uLedgerMax, uValidatedMin, uValidatedMax);
         return ret;
 #ifndef BEAST_DEBUG
     }
@@ -199,4 +234,88 @@ Json::Value doAccountTx (RPC::Context& context)
 #endif
 }
 
+RPC::Status doAccountTxObject (RPC::Context& context, Json::Object& result)
+{
+    auto& params = context.params;
+
+    if (params.isMember(jss::offset) ||
+        params.isMember(jss::count) ||
+        params.isMember(jss::descending) ||
+        params.isMember(jss::ledger_max) ||
+        params.isMember(jss::ledger_min))
+    {
+        // The old interface has no streaming form
+        auto const ret = doAccountTxOld (context);
+        Json::copyFrom (result, ret);
+        return RPC::jsonStatus (ret);
+    }
+
+    std::uint32_t   uLedgerMin;
+    std::uint32_t   uLedgerMax;
+    std::uint32_t   uValidatedMin;
+    std::uint32_t   uValidatedMax;
+    AccountID       account;
+
+    if (auto err = readAccountTx (context, account,
+            uLedgerMin, uLedgerMax, uValidatedMin, uValidatedMax))
+    {
+        Json::copyFrom (result, *err);
+        return RPC::jsonStatus (*err);
+    }
+
+    writeAccountTx (context, result, account,
+        uLedgerMin, uLedgerMax, uValidatedMin, uValidatedMax);
+    return RPC::Status::OK;
+}
+
+RPC::Status doAccountTxBinary (RPC::Context& context, Serializer& s)
+{
+    auto& params = context.params;
+
+    int limit = params.isMember (jss::limit) ?
+            params[jss::limit].asUInt () : -1;
+    bool bForward = params.isMember (jss::forward) && params[jss::forward].asBool ();
+    std::uint32_t   uLedgerMin;
+    std::uint32_t   uLedgerMax;
+    std::uint32_t   uValidatedMin;
+    std::uint32_t   uValidatedMax;
+    AccountID       account;
+
+    if (auto err = readAccountTx (context, account,
+            uLedgerMin, uLedgerMax, uValidatedMin, uValidatedMax))
+        return RPC::jsonStatus (*err);
+
+    Json::Value resumeToken;
+
+    if (params.isMember(jss::marker))
+         resumeToken = params[jss::marker];
+
+    s.add32 (uLedgerMin);
+    s.add32 (uLedgerMax);
+
+    std::uint32_t count = 0;
+    auto const countAt = s.add32 (count);
+    context.netOps.forEachTxAccount (
+        account, uLedgerMin, uLedgerMax, bForward, resumeToken, limit,
+        isUnlimited (context.role),
+        [&](std::uint32_t ledgerIndex, Blob const& rawTxn,
+            Blob const& rawMeta)
+        {
+            s.add32 (ledgerIndex);
+            s.addVL (rawTxn);
+            s.addVL (rawMeta);
+            ++count;
+        });
+    RPC::setU32 (s, countAt, count);
+
+    s.add8 (resumeToken ? 1 : 0);
+    if (resumeToken)
+    {
+        s.add32 (resumeToken[jss::ledger].asUInt());
+        s.add32 (resumeToken[jss::seq].asUInt());
+    }
+
+    return RPC::Status::OK;
+}
+
 } // ripple
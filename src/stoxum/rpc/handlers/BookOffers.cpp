@@ -21,6 +21,7 @@
 #include <stoxum/app/main/Application.h>
 #include <stoxum/app/misc/NetworkOPs.h>
 #include <stoxum/basics/Log.h>
+#include <stoxum/ledger/BookDirs.h>
 #include <stoxum/ledger/ReadView.h>
 #include <stoxum/net/RPCErr.h>
 #include <stoxum/protocol/ErrorCodes.h>
@@ -32,7 +33,14 @@
 
 namespace ripple {
 
-Json::Value doBookOffers (RPC::Context& context)
+namespace {
+
+// Reads the ledger, the book and the taker, returning the result
+// of the ledger lookup or an error.
+Json::Value
+readBookOffers (RPC::Context& context,
+    std::shared_ptr<ReadView const>& lpLedger, Book& book,
+        boost::optional<AccountID>& takerID, unsigned int& limit)
 {
     // VFALCO TODO Here is a terrible place for this kind of business
     //             logic. It needs to be moved elsewhere and documented,
@@ -40,7 +48,6 @@ Json::Value doBookOffers (RPC::Context& context)
     if (context.app.getJobQueue ().getJobCountGE (jtCLIENT) > 200)
         return rpcError (rpcTOO_BUSY);
 
-    std::shared_ptr<ReadView const> lpLedger;
     auto jvResult = RPC::lookupLedger (lpLedger, context);
 
     if (!lpLedger)
@@ -153,7 +160,6 @@ Json::Value doBookOffers (RPC::Context& context)
         return RPC::make_error (rpcDST_ISR_MALFORMED,
             "Invalid field 'taker_gets.issuer', expected non-STM issuer.");
 
-    boost::optional<AccountID> takerID;
     if (context.params.isMember (jss::taker))
     {
         if (! context.params [jss::taker].isString ())
@@ -171,10 +177,26 @@ Json::Value doBookOffers (RPC::Context& context)
         return RPC::make_error (rpcBAD_MARKET);
     }
 
-    unsigned int limit;
     if (auto err = readLimitField(limit, RPC::Tuning::bookOffers, context))
         return *err;
 
+    book = {{pay_currency, pay_issuer}, {get_currency, get_issuer}};
+    return jvResult;
+}
+
+} // namespace
+
+Json::Value doBookOffers (RPC::Context& context)
+{
+    std::shared_ptr<ReadView const> lpLedger;
+    Book book;
+    boost::optional<AccountID> takerID;
+    unsigned int limit;
+    auto jvResult = readBookOffers (
+        context, lpLedger, book, takerID, limit);
+    if (!lpLedger || RPC::contains_error (jvResult))
+        return jvResult;
+
     bool const bProof (context.params.isMember (jss::proof));
 
     Json::Value const jvMarker (context.params.isMember (jss::marker)
@@ -182,8 +204,7 @@ Json::Value doBookOffers (RPC::Context& context)
         : Json::Value (Json::nullValue));
 
     context.netOps.getBookPage (
-        lpLedger,
-        {{pay_currency, pay_issuer}, {get_currency, get_issuer}},
+        lpLedger, book,
         takerID ? *takerID : zero, bProof, limit, jvMarker, jvResult);
 
     context.loadType = Resource::feeMediumBurdenRPC;
@@ -191,4 +212,36 @@ Json::Value doBookOffers (RPC::Context& context)
     return jvResult;
 }
 
+RPC::Status doBookOffersBinary (RPC::Context& context, Serializer& s)
+{
+    std::shared_ptr<ReadView const> lpLedger;
+    Book book;
+    boost::optional<AccountID> takerID;
+    unsigned int limit;
+    auto const jvResult = readBookOffers (
+        context, lpLedger, book, takerID, limit);
+    if (!lpLedger || RPC::contains_error (jvResult))
+        return RPC::jsonStatus (jvResult);
+
+    s.add32 (lpLedger->info().seq);
+
+    std::uint32_t count = 0;
+    auto const countAt = s.add32 (count);
+    Serializer offer;
+    for (auto const& sle : BookDirs (*lpLedger, book))
+    {
+        if (count == limit)
+            break;
+        offer.erase();
+        sle->add (offer);
+        s.addVL (offer.slice());
+        ++count;
+    }
+    RPC::setU32 (s, countAt, count);
+
+    context.loadType = Resource::feeMediumBurdenRPC;
+
+    return RPC::Status::OK;
+}
+
 } // ripple
@@ -33,6 +33,8 @@
 #include <stoxum/protocol/ErrorCodes.h>
 #include <stoxum/protocol/JsonFields.h>
 #include <stoxum/rpc/Context.h>
+#include <stoxum/rpc/RPCResponseCache.h>
+#include <stoxum/rpc/RPCStats.h>
 
 namespace ripple {
 
@@ -106,6 +108,7 @@ Json::Value doGetCounts (RPC::Context& context)
     ret[jss::node_hit_rate] = context.app.getNodeStore ().getCacheHitRate ();
     ret[jss::ledger_hit_rate] = context.app.getLedgerMaster ().getCacheHitRate ();
     ret[jss::AL_hit_rate] = context.app.getAcceptedLedgerCache ().getHitRate ();
+    ret[jss::RPC_hit_rate] = context.app.getRPCResponseCache ().getHitRate ();
 
     ret[jss::fullbelow_size] = static_cast<int>(context.app.family().fullbelow().size());
     ret[jss::treenode_cache_size] = context.app.family().treecache().getCacheSize();
@@ -144,6 +147,8 @@ Json::Value doGetCounts (RPC::Context& context)
         jv[jss::node_read_bytes] = shardStore->getFetchSize();
     }
 
+    ret[jss::rpc_methods] = context.app.getRPCStats().getJson();
+
     return ret;
 }
 
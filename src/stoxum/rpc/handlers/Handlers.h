@@ -20,6 +20,7 @@
 #ifndef RIPPLE_RPC_HANDLERS_HANDLERS_H_INCLUDED
 #define RIPPLE_RPC_HANDLERS_HANDLERS_H_INCLUDED
 
+#include <stoxum/protocol/Serializer.h>
 #include <stoxum/rpc/handlers/LedgerHandler.h>
 
 namespace ripple {
@@ -53,6 +54,7 @@ Json::Value doLedgerData            (RPC::Context&);
 Json::Value doLedgerEntry           (RPC::Context&);
 Json::Value doLedgerHeader          (RPC::Context&);
 Json::Value doLedgerRequest         (RPC::Context&);
+Json::Value doLedgerVerify          (RPC::Context&);
 Json::Value doLogLevel              (RPC::Context&);
 Json::Value doLogRotate             (RPC::Context&);
 Json::Value doNoRippleCheck         (RPC::Context&);
@@ -81,6 +83,16 @@ Json::Value doValidationSeed        (RPC::Context&);
 Json::Value doWalletPropose         (RPC::Context&);
 Json::Value doValidators            (RPC::Context&);
 Json::Value doValidatorListSites    (RPC::Context&);
+
+// Forms of the above that write their result as it is produced
+RPC::Status doAccountTxObject       (RPC::Context&, Json::Object&);
+RPC::Status doLedgerDataObject      (RPC::Context&, Json::Object&);
+
+// Binary forms of the above, see BinaryRPC.h
+RPC::Status doAccountTxBinary       (RPC::Context&, Serializer&);
+RPC::Status doBookOffersBinary      (RPC::Context&, Serializer&);
+RPC::Status doLedgerDataBinary      (RPC::Context&, Serializer&);
+
 } // ripple
 
 #endif
@@ -19,6 +19,7 @@
 
 #include <BeastConfig.h>
 #include <stoxum/app/ledger/LedgerToJson.h>
+#include <stoxum/json/Object.h>
 #include <stoxum/ledger/ReadView.h>
 #include <stoxum/protocol/ErrorCodes.h>
 #include <stoxum/protocol/JsonFields.h>
@@ -30,38 +31,29 @@
 
 namespace ripple {
 
-// Get state nodes from a ledger
-//   Inputs:
-//     limit:        integer, maximum number of entries
-//     marker:       opaque, resume point
-//     binary:       boolean, format
-//     type:         string // optional, defaults to all ledger node types
-//   Outputs:
-//     ledger_hash:  chosen ledger's hash
-//     ledger_index: chosen ledger's index
-//     state:        array of state nodes
-//     marker:       resume point, if any
-Json::Value doLedgerData (RPC::Context& context)
+namespace {
+
+// Reads the ledger and the paging parameters, returning the
+// result of the ledger lookup or an error.
+Json::Value
+readLedgerData (RPC::Context& context, bool isBinary,
+    std::shared_ptr<ReadView const>& lpLedger,
+        ReadView::key_type& key, int& limit, LedgerEntryType& type)
 {
-    std::shared_ptr<ReadView const> lpLedger;
     auto const& params = context.params;
 
     auto jvResult = RPC::lookupLedger(lpLedger, context);
     if (!lpLedger)
         return jvResult;
 
-    bool const isMarker = params.isMember (jss::marker);
-    ReadView::key_type key = ReadView::key_type();
-    if (isMarker)
+    if (params.isMember (jss::marker))
     {
         Json::Value const& jMarker = params[jss::marker];
         if (! (jMarker.isString () && key.SetHex (jMarker.asString ())))
             return RPC::expected_field_error (jss::marker, "valid");
     }
 
-    bool const isBinary = params[jss::binary].asBool();
-
-    int limit = -1;
+    limit = -1;
     if (params.isMember (jss::limit))
     {
         Json::Value const& jLimit = params[jss::limit];
@@ -75,55 +67,181 @@ Json::Value doLedgerData (RPC::Context& context)
     if ((limit < 0) || ((limit > maxLimit) && (! isUnlimited (context.role))))
         limit = maxLimit;
 
-    jvResult[jss::ledger_hash] = to_string (lpLedger->info().hash);
-    jvResult[jss::ledger_index] = lpLedger->info().seq;
-
-    if (! isMarker)
-    {
-        // Return base ledger data on first query
-        jvResult[jss::ledger] = getJson (
-            LedgerFill (*lpLedger, isBinary ?
-                LedgerFill::Options::binary : 0));
-    }
-
-    auto type = RPC::chooseLedgerEntryType(params);
-    if (type.first)
+    auto chosen = RPC::chooseLedgerEntryType(params);
+    if (chosen.first)
     {
         jvResult.clear();
-        type.first.inject(jvResult);
+        chosen.first.inject(jvResult);
         return jvResult;
     }
-    Json::Value& nodes = jvResult[jss::state];
+    type = chosen.second;
+
+    return jvResult;
+}
 
-    auto e = lpLedger->sles.end();
-    for (auto i = lpLedger->sles.upper_bound(key); i != e; ++i)
+// Calls `f` with up to `limit` entries of the chosen type that follow
+// `key`, returning the marker that resumes the walk, if any.
+template <class Function>
+boost::optional<ReadView::key_type>
+forEachEntry (ReadView const& ledger, ReadView::key_type const& key,
+    int limit, LedgerEntryType type, Function&& f)
+{
+    auto e = ledger.sles.end();
+    for (auto i = ledger.sles.upper_bound(key); i != e; ++i)
     {
-        auto sle = lpLedger->read(keylet::unchecked((*i)->key()));
+        auto sle = ledger.read(keylet::unchecked((*i)->key()));
         if (limit-- <= 0)
         {
             // Stop processing before the current key.
             auto k = sle->key();
-            jvResult[jss::marker] = to_string(--k);
-            break;
+            return --k;
         }
 
-        if (type.second == ltINVALID || sle->getType () == type.second)
-        {
-            if (isBinary)
-            {
-                Json::Value& entry = nodes.append (Json::objectValue);
-                entry[jss::data] = serializeHex(*sle);
-                entry[jss::index] = to_string(sle->key());
-            }
-            else
+        if (type == ltINVALID || sle->getType () == type)
+            f (*sle);
+    }
+    return boost::none;
+}
+
+void
+addLedgerHeader (Json::Value& jvResult, ReadView const& ledger,
+    bool isBinary, bool isMarker)
+{
+    jvResult[jss::ledger_hash] = to_string (ledger.info().hash);
+    jvResult[jss::ledger_index] = ledger.info().seq;
+
+    if (! isMarker)
+    {
+        // Return base ledger data on first query
+        jvResult[jss::ledger] = getJson (
+            LedgerFill (ledger, isBinary ?
+                LedgerFill::Options::binary : 0));
+    }
+}
+
+// Writes the state nodes, then the marker if there are more
+template <class Object>
+void
+writeLedgerData (Object& result, ReadView const& ledger,
+    ReadView::key_type const& key, int limit, LedgerEntryType type,
+        bool isBinary)
+{
+    boost::optional<ReadView::key_type> marker;
+    {
+        auto&& nodes = Json::setArray (result, jss::state);
+
+        marker = forEachEntry (ledger, key, limit, type,
+            [&](SLE const& sle)
             {
-                Json::Value& entry = nodes.append (sle->getJson (0));
-                entry[jss::index] = to_string(sle->key());
-            }
-        }
+                if (isBinary)
+                {
+                    auto&& entry = Json::appendObject (nodes);
+                    entry[jss::data] = serializeHex(sle);
+                    entry[jss::index] = to_string(sle.key());
+                }
+                else
+                {
+                    // The entry already carries its index
+                    nodes.append (sle.getJson (0));
+                }
+            });
     }
+    if (marker)
+        result[jss::marker] = to_string(*marker);
+}
+
+} // namespace
+
+// Get state nodes from a ledger
+//   Inputs:
+//     limit:        integer, maximum number of entries
+//     marker:       opaque, resume point
+//     binary:       boolean, format
+//     type:         string // optional, defaults to all ledger node types
+//   Outputs:
+//     ledger_hash:  chosen ledger's hash
+//     ledger_index: chosen ledger's index
+//     state:        array of state nodes
+//     marker:       resume point, if any
+Json::Value doLedgerData (RPC::Context& context)
+{
+    std::shared_ptr<ReadView const> lpLedger;
+    auto const& params = context.params;
+    bool const isBinary = params[jss::binary].asBool();
+
+    ReadView::key_type key = ReadView::key_type();
+    int limit;
+    LedgerEntryType type = ltINVALID;
+    auto jvResult = readLedgerData (
+        context, isBinary, lpLedger, key, limit, type);
+    if (!lpLedger || RPC::contains_error (jvResult))
+        return jvResult;
+
+    addLedgerHeader (jvResult, *lpLedger, isBinary,
+        params.isMember (jss::marker));
+    writeLedgerData (jvResult, *lpLedger, key, limit, type, isBinary);
 
     return jvResult;
 }
 
+RPC::Status doLedgerDataObject (RPC::Context& context, Json::Object& result)
+{
+    std::shared_ptr<ReadView const> lpLedger;
+    auto const& params = context.params;
+    bool const isBinary = params[jss::binary].asBool();
+
+    ReadView::key_type key = ReadView::key_type();
+    int limit;
+    LedgerEntryType type = ltINVALID;
+    auto jvResult = readLedgerData (
+        context, isBinary, lpLedger, key, limit, type);
+    if (!lpLedger || RPC::contains_error (jvResult))
+    {
+        Json::copyFrom (result, jvResult);
+        return RPC::jsonStatus (jvResult);
+    }
+
+    addLedgerHeader (jvResult, *lpLedger, isBinary,
+        params.isMember (jss::marker));
+    Json::copyFrom (result, jvResult);
+    writeLedgerData (result, *lpLedger, key, limit, type, isBinary);
+
+    return RPC::Status::OK;
+}
+
+RPC::Status doLedgerDataBinary (RPC::Context& context, Serializer& s)
+{
+    std::shared_ptr<ReadView const> lpLedger;
+    ReadView::key_type key = ReadView::key_type();
+    int limit;
+    LedgerEntryType type = ltINVALID;
+    auto const jvResult = readLedgerData (
+        context, true, lpLedger, key, limit, type);
+    if (!lpLedger || RPC::contains_error (jvResult))
+        return RPC::jsonStatus (jvResult);
+
+    s.add32 (lpLedger->info().seq);
+    s.add256 (lpLedger->info().hash);
+
+    std::uint32_t count = 0;
+    auto const countAt = s.add32 (count);
+    Serializer entry;
+    auto const marker = forEachEntry (*lpLedger, key, limit, type,
+        [&](SLE const& sle)
+        {
+            entry.erase();
+            sle.add (entry);
+            s.add256 (sle.key());
+            s.addVL (entry.slice());
+            ++count;
+        });
+    RPC::setU32 (s, countAt, count);
+
+    s.add8 (marker ? 1 : 0);
+    if (marker)
+        s.add256 (*marker);
+
+    return RPC::Status::OK;
+}
+
 } // ripple
@@ -0,0 +1,73 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012-2014 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <stoxum/app/ledger/LedgerVerifier.h>
+#include <stoxum/app/main/Application.h>
+#include <stoxum/core/Config.h>
+#include <stoxum/protocol/ErrorCodes.h>
+#include <stoxum/protocol/JsonFields.h>
+#include <stoxum/resource/Fees.h>
+#include <stoxum/rpc/Context.h>
+#include <stoxum/rpc/impl/RPCHelpers.h>
+#include <algorithm>
+#include <thread>
+
+namespace ripple {
+
+// {
+//   min_ledger : <ledger_index>
+//   max_ledger : <ledger_index>
+//   replay : <bool>  // optional, rebuild each ledger from its parent
+// }
+Json::Value doLedgerVerify (RPC::Context& context)
+{
+    auto const& params = context.params;
+
+    if (! params.isMember (jss::min_ledger))
+        return RPC::missing_field_error (jss::min_ledger);
+    if (! params.isMember (jss::max_ledger))
+        return RPC::missing_field_error (jss::max_ledger);
+    if (! params[jss::min_ledger].isIntegral() ||
+            params[jss::min_ledger].asUInt() == 0)
+        return RPC::invalid_field_error (jss::min_ledger);
+    if (! params[jss::max_ledger].isIntegral() ||
+            params[jss::max_ledger].asUInt() < params[jss::min_ledger].asUInt())
+        return RPC::invalid_field_error (jss::max_ledger);
+    if (params.isMember (jss::replay) && ! params[jss::replay].isBool())
+        return RPC::invalid_field_error (jss::replay);
+
+    context.loadType = Resource::feeHighBurdenRPC;
+
+    LedgerVerifier::Setup setup;
+    setup.first = params[jss::min_ledger].asUInt();
+    setup.last = params[jss::max_ledger].asUInt();
+    setup.replay = params.isMember (jss::replay) &&
+        params[jss::replay].asBool();
+    // Keep every job queue thread busy
+    auto const workers = context.app.config().WORKERS;
+    setup.lookahead = std::max<std::size_t> (2,
+        workers ? workers : std::thread::hardware_concurrency());
+
+    LedgerVerifier verifier (context.app,
+        context.app.journal ("LedgerVerifier"));
+    return verifier.run (setup);
+}
+
+} // ripple
@@ -72,6 +72,27 @@ class HandlerTable {
         // This is where the new-style handlers are added.
         addHandler<LedgerHandler>();
         addHandler<VersionHandler>();
+
+        // Commands that can write their result as they go
+        addObject ("account_tx", &doAccountTxObject);
+        addObject ("ledger", &handle<Json::Object, LedgerHandler>);
+        addObject ("ledger_data", &doLedgerDataObject);
+
+        // Commands that can answer in the binary format
+        addBinary ("account_tx", &doAccountTxBinary);
+        addBinary ("book_offers", &doBookOffersBinary);
+        addBinary ("ledger_data", &doLedgerDataBinary);
+
+        // Commands that walk many ledger entries, shed first under load
+        setHeavy ("account_objects");
+        setHeavy ("account_tx");
+        setHeavy ("book_offers");
+        setHeavy ("gateway_balances");
+        setHeavy ("ledger_data");
+        setHeavy ("noripple_check");
+        setHeavy ("path_find");
+        setHeavy ("ripple_path_find");
+        setHeavy ("tx_history");
     }
 
     const Handler* getHandler(std::string name) const {
@@ -95,6 +116,29 @@ class HandlerTable {
 
         table_[HandlerImpl::name()] = h;
     };
+
+    void addObject (std::string const& name,
+        Handler::Method<Json::Object> method)
+    {
+        auto i = table_.find (name);
+        assert (i != table_.end());
+        i->second.objectMethod_ = std::move (method);
+    }
+
+    void addBinary (std::string const& name,
+        Handler::Method<Serializer> method)
+    {
+        auto i = table_.find (name);
+        assert (i != table_.end());
+        i->second.binaryMethod_ = std::move (method);
+    }
+
+    void setHeavy (std::string const& name)
+    {
+        auto i = table_.find (name);
+        assert (i != table_.end());
+        i->second.cost_ = Cost::heavy;
+    }
 };
 
 Handler handlerArray[] {
@@ -127,6 +171,7 @@ Handler handlerArray[] {
     {   "ledger_entry",         byRef (&doLedgerEntry),         Role::USER,  NO_CONDITION  },
     {   "ledger_header",        byRef (&doLedgerHeader),        Role::USER,  NO_CONDITION  },
     {   "ledger_request",       byRef (&doLedgerRequest),       Role::ADMIN,   NO_CONDITION     },
+    {   "ledger_verify",        byRef (&doLedgerVerify),        Role::ADMIN,   NO_CONDITION     },
     {   "log_level",            byRef (&doLogLevel),            Role::ADMIN,   NO_CONDITION     },
     {   "logrotate",            byRef (&doLogRotate),           Role::ADMIN,   NO_CONDITION     },
     {   "noripple_check",       byRef (&doNoRippleCheck),       Role::USER,  NO_CONDITION  },
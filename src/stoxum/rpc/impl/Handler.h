@@ -21,13 +21,11 @@
 #define RIPPLE_RPC_HANDLER_H_INCLUDED
 
 #include <stoxum/core/Config.h>
+#include <stoxum/json/Object.h>
+#include <stoxum/protocol/Serializer.h>
 #include <stoxum/rpc/RPCHandler.h>
 #include <stoxum/rpc/Status.h>
 
-namespace Json {
-class Object;
-}
-
 namespace ripple {
 namespace RPC {
 
@@ -39,6 +37,12 @@ enum Condition {
     NEEDS_CLOSED_LEDGER   = 4 + NEEDS_NETWORK_CONNECTION,
 };
 
+// How much work a call may take, which decides when load is shed
+enum class Cost {
+    light,
+    heavy,
+};
+
 struct Handler
 {
     template <class JsonValue>
@@ -48,6 +52,14 @@ struct Handler
     Method<Json::Value> valueMethod_;
     Role role_;
     RPC::Condition condition_;
+
+    // Writes the result as it goes, for commands with large results
+    Method<Json::Object> objectMethod_;
+
+    // Writes the result in the binary format, if the command has one
+    Method<Serializer> binaryMethod_;
+
+    Cost cost_ = Cost::light;
 };
 
 const Handler* getHandler (std::string const&);
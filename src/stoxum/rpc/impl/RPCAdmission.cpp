@@ -0,0 +1,96 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2017 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+
+#include <BeastConfig.h>
+#include <stoxum/rpc/RPCAdmission.h>
+#include <stoxum/basics/Log.h>
+#include <stoxum/core/JobQueue.h>
+#include <algorithm>
+
+namespace ripple {
+
+RPCAdmission::RPCAdmission (Setup const& setup, JobQueue& jobQueue,
+    beast::insight::Collector::ptr const& collector,
+        beast::Journal journal)
+    : setup_ (setup)
+    , jobQueue_ (jobQueue)
+    , j_ (journal)
+    , refused_ (collector->make_meter ("rpc_refused"))
+{
+}
+
+boost::optional<std::chrono::seconds>
+RPCAdmission::check (Role role, bool heavy)
+{
+    if (isUnlimited (role) || setup_.targetWait.count() == 0)
+        return boost::none;
+
+    auto const wait = std::max (
+        jobQueue_.getQueueWait (jtCLIENT),
+        jobQueue_.getQueueWait (jtRPC));
+
+    auto const retry = decide (setup_, wait, role, heavy);
+    if (retry)
+    {
+        ++refused_;
+        JLOG (j_.debug()) << "Refusing " << (heavy ? "heavy" : "light") <<
+            " call, queue wait " << wait.count() << "us";
+    }
+    return retry;
+}
+
+boost::optional<std::chrono::seconds>
+RPCAdmission::decide (Setup const& setup, std::chrono::microseconds wait,
+    Role role, bool heavy)
+{
+    using namespace std::chrono;
+
+    if (isUnlimited (role) || setup.targetWait.count() == 0)
+        return boost::none;
+
+    if (wait <= setup.targetWait)
+        return boost::none;
+
+    if (! heavy && wait <= setup.targetWait * setup.refuseAllFactor)
+        return boost::none;
+
+    // By the time the jobs now waiting have run the queue should
+    // have drained, so that is how long the client is asked to wait.
+    auto const retry = duration_cast<seconds> (wait + seconds (1) -
+        microseconds (1));
+    return std::max (retry, seconds (1));
+}
+
+RPCAdmission::Setup
+setup_RPCAdmission (Config const& config)
+{
+    RPCAdmission::Setup setup;
+    auto const& section = config.section ("rpc_admission");
+    std::uint32_t targetWait;
+    if (get_if_exists (section, "target_wait_ms", targetWait))
+        setup.targetWait = std::chrono::milliseconds (targetWait);
+    std::uint32_t factor;
+    if (get_if_exists (section, "refuse_all_factor", factor))
+        setup.refuseAllFactor = std::max<int> (factor, 1);
+    return setup;
+}
+
+} // ripple
@@ -20,6 +20,7 @@
 #include <BeastConfig.h>
 #include <stoxum/app/main/Application.h>
 #include <stoxum/rpc/RPCHandler.h>
+#include <stoxum/rpc/BinaryRPC.h>
 #include <stoxum/rpc/impl/Tuning.h>
 #include <stoxum/rpc/impl/Handler.h>
 #include <stoxum/app/main/Application.h>
@@ -36,6 +37,9 @@
 #include <stoxum/protocol/JsonFields.h>
 #include <stoxum/resource/Fees.h>
 #include <stoxum/rpc/Role.h>
+#include <stoxum/rpc/RPCAdmission.h>
+#include <stoxum/rpc/RPCResponseCache.h>
+#include <stoxum/rpc/RPCStats.h>
 #include <stoxum/resource/Fees.h>
 
 namespace ripple {
@@ -110,7 +114,8 @@ namespace {
  */
 
 error_code_i fillHandler (Context& context,
-                          Handler const * & result)
+                          Handler const * & result,
+                          std::chrono::seconds& retryAfter)
 {
     if (! isUnlimited (context.role))
     {
@@ -120,6 +125,7 @@ error_code_i fillHandler (Context& context,
         if (jc > Tuning::maxJobQueueClients)
         {
             JLOG (context.j.debug()) << "Too busy for command: " << jc;
+            retryAfter = std::chrono::seconds (1);
             return rpcTOO_BUSY;
         }
     }
@@ -147,6 +153,13 @@ error_code_i fillHandler (Context& context,
     if (handler->role_ == Role::ADMIN && context.role != Role::ADMIN)
         return rpcNO_PERMISSION;
 
+    if (auto retry = context.app.getRPCAdmission ().check (
+            context.role, handler->cost_ == Cost::heavy))
+    {
+        retryAfter = *retry;
+        return rpcTOO_BUSY;
+    }
+
     if ((handler->condition_ & NEEDS_NETWORK_CONNECTION) &&
         (context.netOps.getOperatingMode () < NetworkOPs::omSYNCING))
     {
@@ -194,15 +207,70 @@ error_code_i fillHandler (Context& context,
     return rpcSUCCESS;
 }
 
+// Reports why a call failed, and when to retry one that was refused
+template <class Object>
+void injectError (error_code_i error,
+    std::chrono::seconds retryAfter, Object& result)
+{
+    inject_error (error, result);
+    if (retryAfter.count () != 0)
+        result[jss::retry_after] =
+            static_cast<Json::UInt> (retryAfter.count ());
+}
+
+// Records how long a call took, once it is done
+class CallTimer
+{
+public:
+    CallTimer (Context& context, std::string const& name)
+        : context_ (context)
+        , name_ (name)
+        , start_ (std::chrono::steady_clock::now())
+    {
+    }
+
+    template <class Object>
+    Status
+    done (Status status, Object const& result)
+    {
+        context_.app.getRPCStats().onCall (name_, context_.params,
+            std::chrono::duration_cast<std::chrono::microseconds> (
+                std::chrono::steady_clock::now() - start_),
+            status || hasError (result));
+        return status;
+    }
+
+private:
+    // Most handlers report errors in their result, not their status
+    static bool
+    hasError (Json::Value const& result)
+    {
+        return result.isObject() && result.isMember (jss::error);
+    }
+
+    template <class Object>
+    static bool
+    hasError (Object const&)
+    {
+        return false;
+    }
+
+    Context& context_;
+    std::string const& name_;
+    std::chrono::steady_clock::time_point const start_;
+};
+
 template <class Object, class Method>
 Status callMethod (
     Context& context, Method method, std::string const& name, Object& result)
 {
+    CallTimer timer (context, name);
     try
     {
         auto v = context.app.getJobQueue().makeLoadEvent(
             jtGENERIC, "cmd:" + name);
-        return method (context, result);
+        auto const status = method (context, result);
+        return timer.done (status, result);
     }
     catch (std::exception& e)
     {
@@ -212,7 +280,7 @@ Status callMethod (
             context.loadType = Resource::feeExceptionRPC;
 
         inject_error (rpcINTERNAL, result);
-        return rpcINTERNAL;
+        return timer.done (Status (rpcINTERNAL), result);
     }
 }
 
@@ -233,42 +301,157 @@ void getResult (
     }
 }
 
+// Calls a handler's valueMethod_, answering from the
+// response cache when the response can not change
+Status callValueMethod (
+    Context& context, Handler const& handler, Json::Value& result)
+{
+    auto& cache = context.app.getRPCResponseCache();
+    auto const request = cache.request (context, handler.name_);
+    if (request)
+    {
+        if (auto const cached = cache.fetch (*request))
+        {
+            result = *cached;
+            return Status::OK;
+        }
+    }
+
+    auto const method = handler.valueMethod_;
+    Status status;
+    if (! context.headers.user.empty() ||
+        ! context.headers.forwardedFor.empty())
+    {
+        JLOG(context.j.debug()) << "start command: " << handler.name_ <<
+            ", X-User: " << context.headers.user << ", X-Forwarded-For: " <<
+                context.headers.forwardedFor;
+
+        status = callMethod (context, method, handler.name_, result);
+
+        JLOG(context.j.debug()) << "finish command: " << handler.name_ <<
+            ", X-User: " << context.headers.user << ", X-Forwarded-For: " <<
+                context.headers.forwardedFor;
+    }
+    else
+    {
+        status = callMethod (context, method, handler.name_, result);
+    }
+
+    if (request && ! status)
+        cache.insert (*request, result);
+    return status;
+}
+
 } // namespace
 
 Status doCommand (
     RPC::Context& context, Json::Value& result)
 {
     Handler const * handler = nullptr;
-    if (auto error = fillHandler (context, handler))
+    std::chrono::seconds retryAfter {0};
+    if (auto error = fillHandler (context, handler, retryAfter))
+    {
+        injectError (error, retryAfter, result);
+        return error;
+    }
+
+    if (handler->valueMethod_)
+        return callValueMethod (context, *handler, result);
+
+    return rpcUNKNOWN_COMMAND;
+}
+
+Status doCommand (
+    RPC::Context& context, Json::Object& result)
+{
+    Handler const * handler = nullptr;
+    std::chrono::seconds retryAfter {0};
+    if (auto error = fillHandler (context, handler, retryAfter))
     {
-        inject_error (error, result);
+        injectError (error, retryAfter, result);
         return error;
     }
 
-    if (auto method = handler->valueMethod_)
+    // Responses that may be kept are built as values
+    auto const cacheable = handler->valueMethod_ &&
+        context.app.getRPCResponseCache().request (context, handler->name_);
+
+    if (auto method = handler->objectMethod_)
     {
-        if (! context.headers.user.empty() ||
-            ! context.headers.forwardedFor.empty())
-        {
-            JLOG(context.j.debug()) << "start command: " << handler->name_ <<
-                ", X-User: " << context.headers.user << ", X-Forwarded-For: " <<
-                    context.headers.forwardedFor;
+        if (! cacheable)
+            return callMethod (context, method, handler->name_, result);
+    }
+
+    if (handler->valueMethod_)
+    {
+        Json::Value value;
+        auto const status = callValueMethod (context, *handler, value);
+        Json::copyFrom (result, value);
+        return status;
+    }
+
+    return rpcUNKNOWN_COMMAND;
+}
 
-            auto ret = callMethod (context, method, handler->name_, result);
+bool streamsResult (std::string const& method)
+{
+    auto handler = RPC::getHandler (method);
+    return handler && handler->objectMethod_;
+}
 
-            JLOG(context.j.debug()) << "finish command: " << handler->name_ <<
-                ", X-User: " << context.headers.user << ", X-Forwarded-For: " <<
-                    context.headers.forwardedFor;
+Status doBinaryCommand (
+    RPC::Context& context, Serializer& result)
+{
+    result.add8 (binaryFormatVersion);
+    auto const start = result.add32 (rpcSUCCESS);
 
-            return ret;
+    Status status;
+    Handler const * handler = nullptr;
+    std::chrono::seconds retryAfter {0};
+    if (auto error = fillHandler (context, handler, retryAfter))
+    {
+        status = error;
+    }
+    else if (! handler->binaryMethod_)
+    {
+        status = rpcUNKNOWN_COMMAND;
+    }
+    else
+    {
+        std::string const name = handler->name_;
+        CallTimer timer (context, name);
+        try
+        {
+            auto v = context.app.getJobQueue().makeLoadEvent(
+                jtGENERIC, "cmd:" + name);
+            status = handler->binaryMethod_ (context, result);
         }
-        else
+        catch (std::exception& e)
         {
-            return callMethod (context, method, handler->name_, result);
+            JLOG (context.j.info()) << "Caught throw: " << e.what ();
+
+            if (context.loadType == Resource::feeReferenceRPC)
+                context.loadType = Resource::feeExceptionRPC;
+
+            status = rpcINTERNAL;
         }
+        timer.done (status, result);
     }
 
-    return rpcUNKNOWN_COMMAND;
+    if (status)
+    {
+        JLOG (context.j.debug()) << "rpcError: " << status.toString();
+
+        // Drop anything written before the error
+        auto const ec = status.toErrorCode();
+        auto const& info = get_error_info (ec);
+        result.modData().resize (start);
+        result.add32 (ec);
+        result.addVL (makeSlice (info.token));
+        result.addVL (makeSlice (status.messages().empty() ?
+            info.message : status.message()));
+    }
+    return status;
 }
 
 Role roleRequired (std::string const& method)
@@ -496,6 +496,24 @@ readLimitField(unsigned int& limit, Tuning::LimitRange const& range,
     return boost::none;
 }
 
+void
+setU32(Serializer& s, int position, std::uint32_t value)
+{
+    auto& data = s.modData();
+    assert (position >= 0 && position + 4 <= static_cast<int> (data.size()));
+    for (int i = 3; i >= 0; --i, value >>= 8)
+        data[position + i] = static_cast<std::uint8_t> (value);
+}
+
+Status
+jsonStatus(Json::Value const& result)
+{
+    if (! contains_error (result))
+        return Status::OK;
+    return { error_code_i (result[jss::error_code].asInt()),
+        result[jss::error_message].asString() };
+}
+
 boost::optional<Seed>
 getSeedFromRPC(Json::Value const& params, Json::Value& error)
 {
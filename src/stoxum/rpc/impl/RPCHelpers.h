@@ -23,6 +23,7 @@
 #include <stoxum/beast/core/SemanticVersion.h>
 #include <stoxum/ledger/TxMeta.h>
 #include <stoxum/protocol/SecretKey.h>
+#include <stoxum/protocol/Serializer.h>
 #include <stoxum/rpc/impl/Tuning.h>
 #include <stoxum/rpc/Status.h>
 #include <boost/optional.hpp>
@@ -109,6 +110,17 @@ injectSLE(Json::Value& jv, SLE const& sle);
 boost::optional<Json::Value>
 readLimitField(unsigned int& limit, Tuning::LimitRange const&, Context const&);
 
+/** Overwrite the value that Serializer::add32 wrote at `position`.
+
+    Binary responses use this to fill in counts once they are known.
+*/
+void
+setU32(Serializer& s, int position, std::uint32_t value);
+
+/** Return the error in a JSON result, if any, as a Status. */
+Status
+jsonStatus(Json::Value const& result);
+
 boost::optional<Seed>
 getSeedFromRPC(Json::Value const& params, Json::Value& error);
 
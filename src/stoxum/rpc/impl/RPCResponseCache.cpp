@@ -0,0 +1,190 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2017 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <stoxum/rpc/RPCResponseCache.h>
+#include <stoxum/app/ledger/LedgerMaster.h>
+#include <stoxum/json/to_string.h>
+#include <stoxum/protocol/digest.h>
+#include <stoxum/protocol/JsonFields.h>
+#include <stoxum/rpc/Context.h>
+#include <stoxum/rpc/Role.h>
+#include <algorithm>
+
+namespace ripple {
+
+namespace {
+
+// Methods whose response depends only on the request and the ledger
+char const* const ledgerMethods[] =
+{
+    "account_info",
+    "book_offers",
+    "ledger",
+};
+
+// Methods whose response never changes once it says it is validated
+char const* const validatedMethods[] =
+{
+    "tx",
+};
+
+template <std::size_t N>
+bool
+contains (char const* const (&methods)[N], std::string const& method)
+{
+    return std::any_of (std::begin (methods), std::end (methods),
+        [&](char const* m) { return method == m; });
+}
+
+// Returns the hash of the validated ledger a request names
+boost::optional<uint256>
+validatedHash (RPC::Context const& context)
+{
+    auto const& params = context.params;
+
+    // The legacy "ledger" field is left to the handler
+    if (params.isMember (jss::ledger))
+        return boost::none;
+
+    if (params.isMember (jss::ledger_hash))
+    {
+        // The handler checks that the ledger is validated
+        auto const& hashValue = params[jss::ledger_hash];
+        uint256 hash;
+        if (! hashValue.isString() || ! hash.SetHex (hashValue.asString()) ||
+                hash.isZero())
+            return boost::none;
+        return hash;
+    }
+
+    auto const& indexValue = params[jss::ledger_index];
+    if (indexValue.isNumeric())
+    {
+        auto const seq = indexValue.asInt();
+        if (seq <= 0 || static_cast<std::uint32_t> (seq) >
+                context.ledgerMaster.getValidLedgerIndex())
+            return boost::none;
+        auto const hash = context.ledgerMaster.getHashBySeq (seq);
+        if (hash.isZero())
+            return boost::none;
+        return hash;
+    }
+
+    if (indexValue.isString() && indexValue.asString() == "validated")
+    {
+        if (auto const ledger = context.ledgerMaster.getValidatedLedger())
+            return ledger->info().hash;
+    }
+
+    return boost::none;
+}
+
+} // (anonymous)
+
+RPCResponseCache::RPCResponseCache (Setup const& setup, Stopwatch& clock,
+    beast::insight::Collector::ptr const& collector,
+        beast::Journal journal)
+    : setup_ (setup)
+    , cache_ ("RPCResponseCache", setup.size,
+        setup.age.count(), clock, journal, collector)
+{
+}
+
+boost::optional<RPCResponseCache::Request>
+RPCResponseCache::request (
+    RPC::Context const& context, std::string const& method) const
+{
+    if (setup_.size <= 0)
+        return boost::none;
+
+    Request request;
+    if (contains (ledgerMethods, method))
+    {
+        auto const& params = context.params;
+
+        // Whole ledgers are streamed, not kept
+        if (params[jss::full].asBool() || params[jss::accounts].asBool())
+            return boost::none;
+
+        auto const hash = validatedHash (context);
+        if (! hash)
+            return boost::none;
+        request.ledgerHash = *hash;
+    }
+    else if (! contains (validatedMethods, method))
+    {
+        return boost::none;
+    }
+
+    // Fields that only tie a response to its request are not part
+    // of the key, and neither are the names of the ledger.
+    Json::Value params (context.params);
+    params.removeMember (jss::id);
+    params.removeMember (jss::jsonrpc);
+    params.removeMember (jss::ripplerpc);
+    params.removeMember (jss::ledger_hash);
+    params.removeMember (jss::ledger_index);
+
+    // Limits depend on the role
+    request.key = sha512Half (method, isUnlimited (context.role),
+        to_string (params), request.ledgerHash);
+    return request;
+}
+
+std::shared_ptr<Json::Value const>
+RPCResponseCache::fetch (Request const& request)
+{
+    return cache_.fetch (request.key);
+}
+
+void
+RPCResponseCache::insert (Request const& request, Json::Value const& result)
+{
+    if (! result.isObject() || result.isMember (jss::error) ||
+            ! result[jss::validated].asBool())
+        return;
+
+    // Make sure the response came from the ledger in the key, as
+    // "validated" may have moved on since the key was made.
+    if (request.ledgerHash.isNonZero() &&
+            result[jss::ledger_hash].asString() != to_string (request.ledgerHash))
+        return;
+
+    if (to_string (result).size() > setup_.maxEntryBytes)
+        return;
+
+    auto entry = std::make_shared<Json::Value> (result);
+    cache_.canonicalize (request.key, entry, true);
+}
+
+RPCResponseCache::Setup
+setup_RPCResponseCache (Config const& config)
+{
+    RPCResponseCache::Setup setup;
+    auto const& section = config.section ("rpc_cache");
+    set (setup.size, "size", section);
+    std::uint32_t age;
+    if (get_if_exists (section, "age", age))
+        setup.age = std::chrono::seconds (age);
+    set (setup.maxEntryBytes, "max_entry_bytes", section);
+    return setup;
+}
+
+} // ripple
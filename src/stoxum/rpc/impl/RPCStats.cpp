@@ -0,0 +1,183 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2017 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+#include <BeastConfig.h>
+#include <stoxum/rpc/RPCStats.h>
+#include <stoxum/basics/Log.h>
+#include <stoxum/json/to_string.h>
+#include <stoxum/protocol/JsonFields.h>
+#include <algorithm>
+#include <cmath>
+
+namespace ripple {
+
+RPCStats::RPCStats (Setup const& setup,
+    beast::insight::Collector::ptr const& collector,
+        beast::Journal journal)
+    : setup_ (setup)
+    , collector_ (collector)
+    , j_ (journal)
+{
+}
+
+void
+RPCStats::onCall (std::string const& method, Json::Value const& params,
+    std::chrono::microseconds elapsed, bool failed)
+{
+    std::size_t bucket = 0;
+    for (auto n = elapsed.count(); n > 1 && bucket + 1 < buckets; n >>= 1)
+        ++bucket;
+
+    {
+        std::lock_guard<std::mutex> lock (mutex_);
+        auto iter = methods_.find (method);
+        if (iter == methods_.end())
+        {
+            iter = methods_.emplace (method, Method{}).first;
+            iter->second.time = collector_->make_event (method);
+            iter->second.bytes = collector_->make_meter (method + "_bytes");
+        }
+
+        auto& m = iter->second;
+        ++m.calls;
+        if (failed)
+            ++m.failures;
+        m.total += elapsed;
+        m.max = std::max (m.max, elapsed);
+        ++m.histogram[bucket];
+        m.time.notify (std::chrono::duration_cast<
+            std::chrono::milliseconds> (elapsed));
+    }
+
+    if (setup_.slowRequest.count() != 0 && elapsed >= setup_.slowRequest)
+    {
+        JLOG (j_.warn()) << "Slow RPC " << method << " took " <<
+            std::chrono::duration_cast<std::chrono::milliseconds> (
+                elapsed).count() << "ms: " << to_string (redact (params));
+    }
+}
+
+void
+RPCStats::onTraffic (std::string const& method,
+    std::size_t requestBytes, std::size_t responseBytes)
+{
+    std::lock_guard<std::mutex> lock (mutex_);
+    auto const iter = methods_.find (method);
+    if (iter == methods_.end())
+        return;
+
+    auto& m = iter->second;
+    m.requestBytes += requestBytes;
+    m.responseBytes += responseBytes;
+    m.bytes += responseBytes;
+}
+
+std::chrono::microseconds
+RPCStats::Method::percentile (double q) const
+{
+    auto const target = static_cast<std::uint64_t> (
+        std::ceil (q * calls));
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < buckets; ++i)
+    {
+        seen += histogram[i];
+        if (seen >= target)
+            return std::min (max,
+                std::chrono::microseconds (std::int64_t (1) << (i + 1)));
+    }
+    return max;
+}
+
+Json::Value
+RPCStats::getJson () const
+{
+    Json::Value ret (Json::objectValue);
+
+    std::lock_guard<std::mutex> lock (mutex_);
+    for (auto const& entry : methods_)
+    {
+        auto const& m = entry.second;
+        Json::Value& method = ret[entry.first];
+        method["calls"] = static_cast<Json::UInt> (m.calls);
+        method["failures"] = static_cast<Json::UInt> (m.failures);
+        method["mean_us"] = static_cast<Json::UInt> (
+            m.total.count() / m.calls);
+        method["p50_us"] = static_cast<Json::UInt> (
+            m.percentile (0.5).count());
+        method["p90_us"] = static_cast<Json::UInt> (
+            m.percentile (0.9).count());
+        method["p99_us"] = static_cast<Json::UInt> (
+            m.percentile (0.99).count());
+        method["max_us"] = static_cast<Json::UInt> (m.max.count());
+        method["request_bytes"] = std::to_string (m.requestBytes);
+        method["response_bytes"] = std::to_string (m.responseBytes);
+    }
+    return ret;
+}
+
+Json::Value
+RPCStats::redact (Json::Value const& params)
+{
+    static char const* const secrets[] =
+    {
+        jss::passphrase.c_str(),
+        jss::secret.c_str(),
+        jss::seed.c_str(),
+        jss::seed_hex.c_str(),
+        "admin_password",
+        "password",
+    };
+
+    if (params.isArray())
+    {
+        Json::Value ret (Json::arrayValue);
+        for (auto const& v : params)
+            ret.append (redact (v));
+        return ret;
+    }
+
+    if (! params.isObject())
+        return params;
+
+    Json::Value ret (Json::objectValue);
+    for (auto iter = params.begin(); iter != params.end(); ++iter)
+    {
+        auto const key = iter.memberName();
+        if (std::any_of (std::begin (secrets), std::end (secrets),
+                [&](char const* s) { return key == s; }))
+            ret[key] = "<redacted>";
+        else
+            ret[key] = redact (*iter);
+    }
+    return ret;
+}
+
+RPCStats::Setup
+setup_RPCStats (Config const& config)
+{
+    RPCStats::Setup setup;
+    auto const& section = config.section ("rpc_stats");
+    std::uint32_t slowRequest;
+    if (get_if_exists (section, "slow_request_ms", slowRequest))
+        setup.slowRequest = std::chrono::milliseconds (slowRequest);
+    return setup;
+}
+
+} // ripple
@@ -23,6 +23,7 @@
 #include <stoxum/beast/rfc2616.h>
 #include <stoxum/beast/net/IPAddressConversion.h>
 #include <stoxum/json/json_reader.h>
+#include <stoxum/json/Object.h>
 #include <stoxum/rpc/json_body.h>
 #include <stoxum/rpc/ServerHandler.h>
 #include <stoxum/server/Server.h>
@@ -38,7 +39,9 @@
 #include <stoxum/resource/ResourceManager.h>
 #include <stoxum/resource/Fees.h>
 #include <stoxum/rpc/impl/Tuning.h>
+#include <stoxum/rpc/BinaryRPC.h>
 #include <stoxum/rpc/RPCHandler.h>
+#include <stoxum/rpc/RPCStats.h>
 #include <stoxum/server/SimpleWriter.h>
 #include <beast/core/detail/base64.hpp>
 #include <beast/http/fields.hpp>
@@ -48,6 +51,7 @@
 #include <boost/optional.hpp>
 #include <boost/regex.hpp>
 #include <algorithm>
+#include <atomic>
 #include <stdexcept>
 
 namespace ripple {
@@ -529,7 +533,16 @@ ServerHandlerImp::processSession (std::shared_ptr<Session> const& session,
             if(iter != session->request().end())
                 return iter->value().to_string();
             return std::string{};
-        }());
+        }(),
+        [&]
+        {
+            auto const iter =
+                session->request().find(
+                    "Accept");
+            return iter != session->request().end() &&
+                iter->value() == RPC::binaryMediaType;
+        }(),
+        session->request().version >= 11);
 
     if(beast::rfc2616::is_keep_alive(session->request()))
         session->complete();
@@ -557,7 +570,8 @@ void
 ServerHandlerImp::processRequest (Port const& port,
     std::string const& request, beast::IP::Endpoint const& remoteIPAddress,
         Output&& output, std::shared_ptr<JobQueue::Coro> coro,
-        std::string forwardedFor, std::string user)
+        std::string forwardedFor, std::string user, bool binary,
+        bool chunked)
 {
     auto rpcJ = app_.journal ("RPC");
 
@@ -588,8 +602,19 @@ ServerHandlerImp::processRequest (Port const& port,
         size = jsonOrig[jss::params].size();
     }
 
+    if (batch && binary)
+    {
+        HTTPReply (400, "Binary batch request", output, rpcJ);
+        return;
+    }
+
     Json::Value reply(batch ? Json::arrayValue : Json::objectValue);
     auto const start (std::chrono::high_resolution_clock::now ());
+    // Traffic is only recorded per method for single requests
+    std::string trafficMethod;
+    // The calls of a batch, run once every entry is checked
+    std::vector<Call> calls;
+    std::vector<Json::Value::ArrayIndex> callIndex;
     for (unsigned i = 0; i < size; ++i)
     {
         Json::Value const& jsonRPC =
@@ -685,6 +710,8 @@ ServerHandlerImp::processRequest (Port const& port,
         }
 
         std::string strMethod = method.asString ();
+        if (! batch)
+            trafficMethod = strMethod;
         if (strMethod.empty())
         {
             usage.charge(Resource::feeInvalidRPC);
@@ -754,65 +781,104 @@ ServerHandlerImp::processRequest (Port const& port,
         JLOG (m_journal.trace())
             << "doRpcCommand:" << strMethod << ":" << params;
 
+        if (batch)
+        {
+            callIndex.push_back (reply.size());
+            reply.append (Json::nullValue);
+            calls.push_back ({std::move (params), usage, role, ripplerpc,
+                forwardedFor, user, Json::Value{}});
+            continue;
+        }
+
         Resource::Charge loadType = Resource::feeReferenceRPC;
 
         RPC::Context context {m_journal, params, app_, loadType, m_networkOPs,
             app_.getLedgerMaster(), usage, role, coro, InfoSub::pointer(),
             {user, forwardedFor}};
-        Json::Value result;
-        RPC::doCommand (context, result);
-        usage.charge (loadType);
-        if (usage.warn())
-            result[jss::warning] = jss::load;
-
-        Json::Value r(Json::objectValue);
-        if (ripplerpc >= "2.0")
+
+        if (binary)
         {
-            if (result.isMember(jss::error))
-            {
-                result[jss::status] = jss::error;
-                result["code"] = result[jss::error_code];
-                result["message"] = result[jss::error_message];
-                result.removeMember(jss::error_message);
-                r[jss::error] = std::move(result);
-                JLOG (m_journal.debug())  <<
-                    "rpcError: " << result [jss::error] <<
-                    ": " << result [jss::error_message];
-            }
-            else
-            {
-                 result[jss::status]  = jss::success;
-                 r[jss::result] = std::move(result);
-            }
+            Serializer s;
+            RPC::doBinaryCommand (context, s);
+            usage.charge (loadType);
+
+            rpc_time_.notify (static_cast <beast::insight::Event::value_type> (
+                std::chrono::duration_cast <std::chrono::milliseconds> (
+                    std::chrono::high_resolution_clock::now () - start)));
+            ++rpc_requests_;
+            rpc_size_.notify (static_cast <beast::insight::Event::value_type> (
+                s.size ()));
+            app_.getRPCStats().onTraffic (strMethod, request.size(), s.size());
+
+            HTTPBinaryReply (RPC::binaryMediaType, s.slice(), output, rpcJ);
+            return;
         }
-        else
+
+        if (chunked && ! batch && ripplerpc < "2.0" &&
+            RPC::streamsResult (strMethod))
         {
-            // Always report "status".  On an error report the request as received.
-            if (result.isMember (jss::error))
+            // Write the reply as the result is produced, rather than
+            // holding all of it in memory
+            HTTPChunkedReply reply (output, rpcJ);
             {
-                result[jss::status] = jss::error;
-                result[jss::request] = params;
-                JLOG (m_journal.debug())  <<
-                    "rpcError: " << result [jss::error] <<
-                    ": " << result [jss::error_message];
-            }
-            else
-            {
-                result[jss::status]  = jss::success;
+                Json::Writer writer (
+                    [&reply](beast::string_view const& s)
+                    {
+                        reply.write (s);
+                    });
+                Json::Object::Root r (writer);
+                {
+                    auto result = Json::addObject (r, jss::result);
+                    auto const status = RPC::doCommand (context, result);
+                    usage.charge (loadType);
+                    if (usage.warn())
+                        result[jss::warning] = jss::load;
+
+                    if (status)
+                    {
+                        result[jss::status] = jss::error;
+                        result[jss::request] = params;
+                        JLOG (m_journal.debug()) <<
+                            "rpcError: " << status.toString();
+                    }
+                    else
+                    {
+                        result[jss::status] = jss::success;
+                    }
+                }
+
+                if (params.isMember(jss::jsonrpc))
+                    r[jss::jsonrpc] = params[jss::jsonrpc];
+                if (params.isMember(jss::ripplerpc))
+                    r[jss::ripplerpc] = params[jss::ripplerpc];
+                if (params.isMember(jss::id))
+                    r[jss::id] = params[jss::id];
             }
-            r[jss::result] = std::move(result);
+            reply.write ("\n");
+            reply.finish ();
+
+            rpc_time_.notify (static_cast <beast::insight::Event::value_type> (
+                std::chrono::duration_cast <std::chrono::milliseconds> (
+                    std::chrono::high_resolution_clock::now () - start)));
+            ++rpc_requests_;
+            rpc_size_.notify (static_cast <beast::insight::Event::value_type> (
+                reply.size ()));
+            app_.getRPCStats().onTraffic (
+                strMethod, request.size(), reply.size());
+            return;
         }
 
-        if (params.isMember(jss::jsonrpc))
-            r[jss::jsonrpc] = params[jss::jsonrpc];
-        if (params.isMember(jss::ripplerpc))
-           r[jss::ripplerpc] = params[jss::ripplerpc];
-        if (params.isMember(jss::id))
-            r[jss::id] = params[jss::id];
-        if (batch)
-            reply.append(std::move(r));
-        else
-            reply = std::move(r);
+        Call call {std::move (params), usage, role, ripplerpc,
+            forwardedFor, user, Json::Value{}};
+        processCall (call, coro);
+        reply = std::move (call.reply);
+    }
+
+    if (! calls.empty())
+    {
+        processBatch (calls, coro);
+        for (std::size_t i = 0; i < calls.size(); ++i)
+            reply[callIndex[i]] = std::move (calls[i].reply);
     }
     auto response = to_string (reply);
 
@@ -822,6 +888,9 @@ ServerHandlerImp::processRequest (Port const& port,
     ++rpc_requests_;
     rpc_size_.notify (static_cast <beast::insight::Event::value_type> (
         response.size ()));
+    if (! batch)
+        app_.getRPCStats().onTraffic (
+            trafficMethod, request.size(), response.size());
 
     response += '\n';
 
@@ -837,6 +906,115 @@ ServerHandlerImp::processRequest (Port const& port,
     HTTPReply (200, response, output, rpcJ);
 }
 
+void
+ServerHandlerImp::processCall (
+    Call& call, std::shared_ptr<JobQueue::Coro> const& coro)
+{
+    auto& params = call.params;
+    Resource::Charge loadType = Resource::feeReferenceRPC;
+
+    RPC::Context context {m_journal, params, app_, loadType, m_networkOPs,
+        app_.getLedgerMaster(), call.usage, call.role, coro,
+        InfoSub::pointer(), {call.user, call.forwardedFor}};
+
+    Json::Value result;
+    RPC::doCommand (context, result);
+    call.usage.charge (loadType);
+    if (call.usage.warn())
+        result[jss::warning] = jss::load;
+
+    Json::Value r(Json::objectValue);
+    if (call.ripplerpc >= "2.0")
+    {
+        if (result.isMember(jss::error))
+        {
+            result[jss::status] = jss::error;
+            result["code"] = result[jss::error_code];
+            result["message"] = result[jss::error_message];
+            result.removeMember(jss::error_message);
+            r[jss::error] = std::move(result);
+            JLOG (m_journal.debug())  <<
+                "rpcError: " << result [jss::error] <<
+                ": " << result [jss::error_message];
+        }
+        else
+        {
+             result[jss::status]  = jss::success;
+             r[jss::result] = std::move(result);
+        }
+    }
+    else
+    {
+        // Always report "status".  On an error report the request as received.
+        if (result.isMember (jss::error))
+        {
+            result[jss::status] = jss::error;
+            result[jss::request] = params;
+            JLOG (m_journal.debug())  <<
+                "rpcError: " << result [jss::error] <<
+                ": " << result [jss::error_message];
+        }
+        else
+        {
+            result[jss::status]  = jss::success;
+        }
+        r[jss::result] = std::move(result);
+    }
+
+    if (params.isMember(jss::jsonrpc))
+        r[jss::jsonrpc] = params[jss::jsonrpc];
+    if (params.isMember(jss::ripplerpc))
+       r[jss::ripplerpc] = params[jss::ripplerpc];
+    if (params.isMember(jss::id))
+        r[jss::id] = params[jss::id];
+    call.reply = std::move (r);
+}
+
+void
+ServerHandlerImp::processBatch (std::vector<Call>& calls,
+    std::shared_ptr<JobQueue::Coro> const& coro)
+{
+    // Each call runs in its own coroutine, so that calls which
+    // suspend do not hold up the others. This coroutine waits
+    // for each group of calls to finish.
+    for (std::size_t first = 0; first < calls.size();
+        first += RPC::Tuning::maxBatchConcurrency)
+    {
+        auto const last = std::min<std::size_t> (calls.size(),
+            first + RPC::Tuning::maxBatchConcurrency);
+
+        // One more than the calls left, until all are started
+        std::atomic<std::size_t> remaining (last - first + 1);
+        auto const done = [&remaining, &coro]
+        {
+            if (--remaining == 0)
+                coro->post();
+        };
+
+        for (auto i = first; i < last; ++i)
+        {
+            auto& call = calls[i];
+            if (! m_jobQueue.postCoro (jtCLIENT, "RPC-Batch",
+                [this, &call, &done](std::shared_ptr<JobQueue::Coro> c)
+                {
+                    processCall (call, c);
+                    done();
+                }))
+            {
+                // The coroutine was rejected, probably because
+                // we're shutting down.
+                call.reply = call.params;
+                call.reply[jss::error] = make_json_error (
+                    server_overloaded, "Server is shutting down");
+                --remaining;
+            }
+        }
+
+        if (--remaining != 0)
+            coro->yield();
+    }
+}
+
 //------------------------------------------------------------------------------
 
 /*  This response is used with load balancing.
@@ -947,6 +1125,7 @@ to_Port(ParsedPort const& parsed, std::ostream& log)
     p.ssl_ciphers = parsed.ssl_ciphers;
     p.pmd_options = parsed.pmd_options;
     p.ws_queue_limit = parsed.ws_queue_limit;
+    p.ws_queue_bytes = parsed.ws_queue_bytes;
     p.limit = parsed.limit;
 
     return p;
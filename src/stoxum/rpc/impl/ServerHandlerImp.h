@@ -26,6 +26,8 @@
 #include <stoxum/server/Session.h>
 #include <stoxum/server/WSSession.h>
 #include <stoxum/rpc/RPCHandler.h>
+#include <stoxum/rpc/Role.h>
+#include <stoxum/resource/Consumer.h>
 #include <stoxum/app/main/CollectorManager.h>
 #include <stoxum/json/Output.h>
 #include <map>
@@ -160,11 +162,35 @@ private:
     processSession (std::shared_ptr<Session> const&,
         std::shared_ptr<JobQueue::Coro> coro);
 
+    // If `binary` is set the reply uses the binary format, see BinaryRPC.h.
+    // If `chunked` is set, large results are sent as they are produced.
     void
     processRequest (Port const& port, std::string const& request,
         beast::IP::Endpoint const& remoteIPAddress, Output&&,
         std::shared_ptr<JobQueue::Coro> coro,
-        std::string forwardedFor, std::string user);
+        std::string forwardedFor, std::string user, bool binary,
+        bool chunked);
+
+    // One call of a request, with the reply to it
+    struct Call
+    {
+        Json::Value params;
+        Resource::Consumer usage;
+        Role role;
+        std::string ripplerpc;
+        std::string forwardedFor;
+        std::string user;
+        Json::Value reply;
+    };
+
+    // Runs a call, filling in its reply
+    void
+    processCall (Call& call, std::shared_ptr<JobQueue::Coro> const& coro);
+
+    // Runs the calls of a batch request, several at once
+    void
+    processBatch (std::vector<Call>& calls,
+        std::shared_ptr<JobQueue::Coro> const& coro);
 
     Handoff
     statusResponse(http_request_type const& request) const;
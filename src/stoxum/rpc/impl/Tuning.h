@@ -59,6 +59,9 @@ using namespace std::chrono_literals;
 auto constexpr maxValidatedLedgerAge = 2min;
 static int const maxRequestSize = 1000000;
 
+/** Most entries of a batch request run at once. */
+static int const maxBatchConcurrency = 8;
+
 /** Maximum number of pages in one response from a binary LedgerData request. */
 static int const binaryPageLength = 2048;
 
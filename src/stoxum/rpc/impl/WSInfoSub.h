@@ -24,6 +24,7 @@
 #include <stoxum/net/InfoSub.h>
 #include <stoxum/beast/net/IPAddressConversion.h>
 #include <stoxum/json/json_writer.h>
+#include <stoxum/protocol/JsonFields.h>
 #include <stoxum/rpc/Role.h>
 #include <memory>
 #include <string>
@@ -68,22 +69,33 @@ public:
     }
 
     void
-    send(Json::Value const& jv, bool)
+    send(Json::Value const& jv, bool broadcast) override
+    {
+        send(Message(jv), broadcast);
+    }
+
+    void
+    send(Message const& msg, bool) override
     {
         auto sp = ws_.lock();
         if(! sp)
             return;
-        beast::multi_buffer sb;
-        Json::stream(jv,
-            [&](void const* data, std::size_t n)
-            {
-                sb.commit(boost::asio::buffer_copy(
-                    sb.prepare(n), boost::asio::buffer(data, n)));
-            });
-        auto m = std::make_shared<
-            StreambufWSMsg<decltype(sb)>>(
-                std::move(sb));
-        sp->send(m);
+        sp->send(std::make_shared<SharedWSMsg>(
+            msg.text(), supersededKind(msg.json())));
+    }
+
+private:
+    // Stream messages that only matter until a newer one is sent
+    static
+    std::string
+    supersededKind(Json::Value const& jv)
+    {
+        if (! jv.isObject() || ! jv.isMember(jss::type))
+            return {};
+        auto const type = jv[jss::type].asString();
+        if (type == "serverStatus" || type == "ledgerClosed")
+            return type;
+        return {};
     }
 };
 
@@ -61,6 +61,9 @@ struct Port
     // Websocket disconnects if send queue exceeds this limit
     std::uint16_t ws_queue_limit;
 
+    // Websocket disconnects if its send queue holds more bytes
+    std::size_t ws_queue_bytes = 16 * 1024 * 1024;
+
     // Returns `true` if any websocket protocols are specified
     bool websockets() const;
 
@@ -91,6 +94,7 @@ struct ParsedPort
     beast::websocket::permessage_deflate pmd_options;
     int limit = 0;
     std::uint16_t ws_queue_limit;
+    std::size_t ws_queue_bytes = 16 * 1024 * 1024;
 
     boost::optional<boost::asio::ip::address> ip;
     boost::optional<std::uint16_t> port;
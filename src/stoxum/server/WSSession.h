@@ -30,6 +30,7 @@
 #include <algorithm>
 #include <functional>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -65,6 +66,28 @@ public:
         std::vector<boost::asio::const_buffer>>
     prepare(std::size_t bytes,
         std::function<void(void)> resume) = 0;
+
+    /** The number of bytes in the message, or zero if not known. */
+    virtual
+    std::size_t
+    size() const
+    {
+        return 0;
+    }
+
+    /** Messages of the same kind supersede each other.
+
+        A message that has not started to be written is dropped when
+        a newer one of the same kind is sent. Messages with no kind
+        are never dropped.
+    */
+    virtual
+    std::string const&
+    kind() const
+    {
+        static std::string const none;
+        return none;
+    }
 };
 
 template<class Streambuf>
@@ -72,13 +95,21 @@ class StreambufWSMsg : public WSMsg
 {
     Streambuf sb_;
     std::size_t n_ = 0;
+    std::size_t size_;
 
 public:
     StreambufWSMsg(Streambuf&& sb)
         : sb_(std::move(sb))
+        , size_(sb_.size())
     {
     }
 
+    std::size_t
+    size() const override
+    {
+        return size_;
+    }
+
     std::pair<boost::tribool,
         std::vector<boost::asio::const_buffer>>
     prepare(std::size_t bytes,
@@ -106,6 +137,54 @@ public:
     }
 };
 
+/** A message whose bytes are shared with other sessions.
+
+    The buffer is never modified, so one rendering of a published
+    message can be queued on any number of sessions.
+*/
+class SharedWSMsg : public WSMsg
+{
+    std::shared_ptr<std::string const> data_;
+    std::string kind_;
+    std::size_t pos_ = 0;
+    std::size_t n_ = 0;
+
+public:
+    explicit
+    SharedWSMsg(std::shared_ptr<std::string const> data,
+            std::string kind = {})
+        : data_(std::move(data))
+        , kind_(std::move(kind))
+    {
+    }
+
+    std::size_t
+    size() const override
+    {
+        return data_->size();
+    }
+
+    std::string const&
+    kind() const override
+    {
+        return kind_;
+    }
+
+    std::pair<boost::tribool,
+        std::vector<boost::asio::const_buffer>>
+    prepare(std::size_t bytes,
+        std::function<void(void)>) override
+    {
+        pos_ += n_;
+        auto const remain = data_->size() - pos_;
+        if (remain == 0)
+            return{true, {}};
+        n_ = std::min(bytes, remain);
+        return{n_ == remain, {boost::asio::const_buffer(
+            data_->data() + pos_, n_)}};
+    }
+};
+
 struct WSSession
 {
     std::shared_ptr<void> appDefined;
@@ -25,10 +25,12 @@
 #include <stoxum/server/impl/io_list.h>
 #include <stoxum/beast/net/IPAddressConversion.h>
 #include <stoxum/beast/asio/ssl_error.h> // for is_short_read?
+#include <stoxum/beast/rfc2616.h>
 #include <beast/http/read.hpp>
 #include <beast/http/message.hpp>
 #include <beast/http/parser.hpp>
 #include <beast/http/dynamic_body.hpp>
+#include <beast/websocket/rfc6455.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/ssl/stream.hpp>
 #include <boost/asio/streambuf.hpp>
@@ -36,6 +38,7 @@
 #include <atomic>
 #include <cassert>
 #include <chrono>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -64,7 +67,10 @@ protected:
 
         // Max seconds without completing a message
         timeoutSeconds = 30,
-        timeoutSecondsLocal = 3 //used for localhost clients
+        timeoutSecondsLocal = 3, //used for localhost clients
+
+        // Most requests from one connection handled at once
+        pipelineLimit = 8
     };
 
     struct buffer
@@ -82,6 +88,16 @@ protected:
         std::size_t used;
     };
 
+    class RequestSession;
+
+    // A request whose response has not all been queued for sending
+    struct Pending
+    {
+        // Written while an earlier response was still pending
+        std::vector<buffer> data;
+        bool complete = false;
+    };
+
     Port const& port_;
     Handler& handler_;
     boost::asio::io_service::work work_;
@@ -99,9 +115,21 @@ protected:
     std::vector<buffer> wq2_;
     std::mutex mutex_;
     bool graceful_ = false;
-    bool complete_ = false;
     boost::system::error_code ec_;
 
+    // Requests handed to the handler, in the order they were read.
+    // Responses are sent in the same order, so while the first is
+    // pending the others are buffered. Guarded by mutex_.
+    std::deque<Pending> pipeline_;
+    std::size_t pipelineStart_ = 0;
+    std::size_t pipelineNext_ = 0;
+
+    // A read of the next request is in progress
+    bool reading_ = false;
+
+    // message_ holds a request that waits for the pipeline to drain
+    bool held_ = false;
+
     int request_count_ = 0;
     std::size_t bytes_in_ = 0;
     std::size_t bytes_out_ = 0;
@@ -147,6 +175,31 @@ protected:
     void
     do_read(yield_context do_yield);
 
+    // Reads the next request, if there is room for it
+    void
+    maybe_read();
+
+    // Closes the connection once every response is sent
+    void
+    maybe_close();
+
+    // Returns `true` if the request may run while others are running
+    bool
+    pipelinable(http_request_type const& request) const;
+
+    // Hands the request in message_ to the handler
+    void
+    dispatch();
+
+    void
+    start_write();
+
+    void
+    write(std::size_t id, void const* buffer, std::size_t bytes);
+
+    void
+    finish(std::size_t id, bool graceful);
+
     void
     on_write(error_code const& ec,
         std::size_t bytes_transferred);
@@ -321,19 +374,105 @@ void
 BaseHTTPPeer<Handler, Impl>::
 do_read(yield_context do_yield)
 {
-    complete_ = false;
+    reading_ = true;
     error_code ec;
-    start_timer();
+    // The timeout only applies while no request is running
+    bool const idle = [&]
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return pipeline_.empty();
+        }();
+    if(idle)
+        start_timer();
     beast::http::async_read(impl().stream_,
         read_buf_, message_, do_yield[ec]);
     cancel_timer();
+    reading_ = false;
     if(ec == beast::http::error::end_of_stream)
-        return do_close();
+    {
+        graceful_ = true;
+        return maybe_close();
+    }
     if(ec)
         return fail(ec, "http::read");
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if(! pipeline_.empty() && ! pipelinable(message_))
+        {
+            held_ = true;
+            return;
+        }
+    }
     do_request();
 }
 
+template<class Handler, class Impl>
+void
+BaseHTTPPeer<Handler, Impl>::
+maybe_read()
+{
+    if(reading_ || held_ || graceful_ || ec_)
+        return;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if(pipeline_.size() >= pipelineLimit)
+            return;
+    }
+    reading_ = true;
+    boost::asio::spawn(strand_,
+        std::bind(&BaseHTTPPeer<Handler, Impl>::do_read,
+            impl().shared_from_this(), std::placeholders::_1));
+}
+
+template<class Handler, class Impl>
+void
+BaseHTTPPeer<Handler, Impl>::
+maybe_close()
+{
+    if(! graceful_)
+        return;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if(! pipeline_.empty() || ! wq_.empty() || ! wq2_.empty())
+            return;
+    }
+    do_close();
+}
+
+template<class Handler, class Impl>
+bool
+BaseHTTPPeer<Handler, Impl>::
+pipelinable(http_request_type const& request) const
+{
+    // Anything that could be handed off waits for
+    // the responses to the earlier requests.
+    return request.method() == beast::http::verb::post &&
+        ! beast::websocket::is_upgrade(request) &&
+        port_.protocol.count("peer") == 0;
+}
+
+template<class Handler, class Impl>
+void
+BaseHTTPPeer<Handler, Impl>::
+dispatch()
+{
+    // Connection: close ends the pipeline
+    if(! beast::rfc2616::is_keep_alive(message_))
+        graceful_ = true;
+    std::size_t id;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        id = pipelineNext_++;
+        pipeline_.emplace_back();
+    }
+    auto const session = std::make_shared<RequestSession>(
+        *this, impl().shared_from_this(), id, std::move(message_));
+    message_ = {};
+    handler_.onRequest(*session);
+    // Read ahead while the request runs
+    maybe_read();
+}
+
 // Send everything in the write queue.
 // The write queue must not be empty upon entry.
 template<class Handler, class Impl>
@@ -364,13 +503,7 @@ on_write(error_code const& ec,
                 impl().shared_from_this(), std::placeholders::_1,
                     std::placeholders::_2)));
     }
-    if(! complete_)
-        return;
-    if(graceful_)
-        return do_close();
-    boost::asio::spawn(strand_,
-        std::bind(&BaseHTTPPeer<Handler, Impl>::do_read,
-            impl().shared_from_this(), std::placeholders::_1));
+    maybe_close();
 }
 
 template<class Handler, class Impl>
@@ -409,8 +542,7 @@ do_writer(std::shared_ptr <Writer> const& writer,
     if(! keep_alive)
         return do_close();
 
-    boost::asio::spawn(strand_, std::bind(&BaseHTTPPeer<Handler, Impl>::do_read,
-        impl().shared_from_this(), std::placeholders::_1));
+    maybe_read();
 }
 
 //------------------------------------------------------------------------------
@@ -431,16 +563,105 @@ write(
             return wq_.size() == 1 && wq2_.size() == 0;
         }())
     {
-        if(! strand_.running_in_this_thread())
-            return strand_.post(std::bind(
-                &BaseHTTPPeer::on_write,
-                    impl().shared_from_this(),
-                        error_code{}, 0));
-        else
-            return on_write(error_code{}, 0);
+        start_write();
     }
 }
 
+// Start sending the write queue
+template<class Handler, class Impl>
+void
+BaseHTTPPeer<Handler, Impl>::
+start_write()
+{
+    if(! strand_.running_in_this_thread())
+        return strand_.post(std::bind(
+            &BaseHTTPPeer::on_write,
+                impl().shared_from_this(),
+                    error_code{}, 0));
+    on_write(error_code{}, 0);
+}
+
+// Send a copy of the data written for a request, or buffer
+// it if the response to an earlier request is pending.
+template<class Handler, class Impl>
+void
+BaseHTTPPeer<Handler, Impl>::
+write(std::size_t id, void const* buffer, std::size_t bytes)
+{
+    if(bytes == 0)
+        return;
+    if([&]
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if(id < pipelineStart_)
+                return false;
+            if(id != pipelineStart_)
+            {
+                pipeline_[id - pipelineStart_].data.emplace_back(
+                    buffer, bytes);
+                return false;
+            }
+            wq_.emplace_back(buffer, bytes);
+            return wq_.size() == 1 && wq2_.size() == 0;
+        }())
+    {
+        start_write();
+    }
+}
+
+// Called when the response to a request is complete
+template<class Handler, class Impl>
+void
+BaseHTTPPeer<Handler, Impl>::
+finish(std::size_t id, bool graceful)
+{
+    if(! strand_.running_in_this_thread())
+        return strand_.post(std::bind(&BaseHTTPPeer<Handler, Impl>::finish,
+            impl().shared_from_this(), id, graceful));
+
+    if(graceful)
+        graceful_ = true;
+
+    bool send = false;
+    bool drained = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if(id < pipelineStart_)
+            return;
+        pipeline_[id - pipelineStart_].complete = true;
+        // Queue the responses that can now be sent
+        bool const idle = wq_.empty() && wq2_.empty();
+        while(! pipeline_.empty() && pipeline_.front().complete)
+        {
+            pipeline_.pop_front();
+            ++pipelineStart_;
+            if(pipeline_.empty())
+                break;
+            for(auto& b : pipeline_.front().data)
+                wq_.emplace_back(std::move(b));
+            pipeline_.front().data.clear();
+        }
+        send = idle && ! wq_.empty();
+        drained = pipeline_.empty();
+    }
+    if(send)
+        on_write(error_code{}, 0);
+
+    if(! drained)
+        return maybe_read();
+    if(graceful_)
+        return maybe_close();
+    if(held_)
+    {
+        held_ = false;
+        return do_request();
+    }
+    if(reading_)
+        start_timer();
+    else
+        maybe_read();
+}
+
 template<class Handler, class Impl>
 void
 BaseHTTPPeer<Handler, Impl>::
@@ -474,17 +695,9 @@ complete()
             impl().shared_from_this()));
 
     message_ = {};
-    complete_ = true;
-
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        if(! wq_.empty() && ! wq2_.empty())
-            return;
-    }
 
     // keep-alive
-    boost::asio::spawn(strand_, std::bind(&BaseHTTPPeer<Handler, Impl>::do_read,
-        impl().shared_from_this(), std::placeholders::_1));
+    maybe_read();
 }
 
 // DEPRECATED
@@ -499,22 +712,111 @@ close(bool graceful)
            (void(BaseHTTPPeer::*)(bool))&BaseHTTPPeer<Handler, Impl>::close,
                 impl().shared_from_this(), graceful));
 
-    complete_ = true;
     if(graceful)
     {
         graceful_ = true;
-        {
-            std::lock_guard<std::mutex> lock(mutex_);
-            if(! wq_.empty() || ! wq2_.empty())
-                return;
-        }
-        return do_close();
+        return maybe_close();
     }
 
     error_code ec;
     impl().stream_.lowest_layer().close(ec);
 }
 
+//------------------------------------------------------------------------------
+
+// The session handed to the handler for one request. Its writes are
+// buffered by the peer until the earlier responses have been sent.
+template<class Handler, class Impl>
+class BaseHTTPPeer<Handler, Impl>::RequestSession
+    : public Session
+    , public std::enable_shared_from_this<RequestSession>
+{
+    BaseHTTPPeer& peer_;
+    std::shared_ptr<Impl> sp_;
+    std::size_t const id_;
+    http_request_type message_;
+
+public:
+    RequestSession(BaseHTTPPeer& peer, std::shared_ptr<Impl> sp,
+            std::size_t id, http_request_type&& message)
+        : peer_(peer)
+        , sp_(std::move(sp))
+        , id_(id)
+        , message_(std::move(message))
+    {
+    }
+
+    ~RequestSession()
+    {
+        // A handler that drops the session ends its response
+        peer_.finish(id_, false);
+    }
+
+    beast::Journal
+    journal() override
+    {
+        return peer_.journal();
+    }
+
+    Port const&
+    port() override
+    {
+        return peer_.port();
+    }
+
+    beast::IP::Endpoint
+    remoteAddress() override
+    {
+        return peer_.remoteAddress();
+    }
+
+    http_request_type&
+    request() override
+    {
+        return message_;
+    }
+
+    void
+    write(void const* buffer, std::size_t bytes) override
+    {
+        peer_.write(id_, buffer, bytes);
+    }
+
+    // Only used for handoffs, which are never pipelined
+    void
+    write(std::shared_ptr <Writer> const& writer,
+        bool keep_alive) override
+    {
+        peer_.write(writer, keep_alive);
+    }
+
+    std::shared_ptr<Session>
+    detach() override
+    {
+        return this->shared_from_this();
+    }
+
+    void
+    complete() override
+    {
+        peer_.finish(id_, false);
+    }
+
+    void
+    close(bool graceful) override
+    {
+        if(graceful)
+            return peer_.finish(id_, true);
+        peer_.close();
+    }
+
+    std::shared_ptr<WSSession>
+    websocketUpgrade() override
+    {
+        return sp_->websocketUpgrade();
+    }
+};
+
 } // ripple
 
 #endif
@@ -21,6 +21,7 @@
 #define RIPPLE_SERVER_BASEWSPEER_H_INCLUDED
 
 #include <stoxum/server/impl/BasePeer.h>
+#include <stoxum/server/impl/WSQueue.h>
 #include <stoxum/protocol/BuildInfo.h>
 #include <stoxum/beast/utility/rngfill.h>
 #include <stoxum/crypto/csprng.h>
@@ -50,7 +51,7 @@ private:
     http_request_type request_;
     beast::multi_buffer rb_;
     beast::multi_buffer wb_;
-    std::list<std::shared_ptr<WSMsg>> wq_;
+    WSQueue wq_;
     bool do_close_ = false;
     beast::websocket::close_reason cr_;
     waitable_timer timer_;
@@ -69,6 +70,8 @@ public:
         boost::asio::io_service& io_service,
         beast::Journal journal);
 
+    ~BaseWSPeer();
+
     void
     run() override;
 
@@ -167,10 +170,22 @@ BaseWSPeer(
     : BasePeer<Handler, Impl>(port, handler, remote_address,
         io_service, journal)
     , request_(std::move(request))
+    , wq_(port.ws_queue_limit, port.ws_queue_bytes)
     , timer_(io_service)
 {
 }
 
+template<class Handler, class Impl>
+BaseWSPeer<Handler, Impl>::
+~BaseWSPeer()
+{
+    auto const& stats = wq_.stats();
+    JLOG(this->j_.debug()) <<
+        "sent " << stats.sent << " messages, " <<
+        stats.sentBytes << " bytes, coalesced " << stats.coalesced <<
+        ", peak queue " << stats.peakBytes << " bytes";
+}
+
 template<class Handler, class Impl>
 void
 BaseWSPeer<Handler, Impl>::
@@ -206,17 +221,17 @@ send(std::shared_ptr<WSMsg> w)
                 std::move(w)));
     if(do_close_)
         return;
-    if(wq_.size() > port().ws_queue_limit)
+    if(! wq_.push(std::move(w)))
     {
         JLOG(this->j_.info()) <<
-            "closing slow client";
+            "closing slow client, " << wq_.size() << " messages, " <<
+            wq_.bytes() << " bytes queued";
         cr_.code = static_cast<beast::websocket::close_code>(4000);
         cr_.reason = "Client is too slow.";
-        wq_.erase(std::next(wq_.begin()), wq_.end());
+        wq_.drop_pending();
         close();
         return;
     }
-    wq_.emplace_back(std::move(w));
     if(wq_.size() == 1)
         on_write({});
 }
@@ -276,7 +291,7 @@ on_write(error_code const& ec)
 {
     if(ec)
         return fail(ec, "write");
-    auto& w = *wq_.front();
+    auto& w = wq_.front();
     auto const result = w.prepare(65536,
         std::bind(&BaseWSPeer::do_write,
             impl().shared_from_this()));
@@ -302,7 +317,7 @@ on_write_fin(error_code const& ec)
 {
     if(ec)
         return fail(ec, "write_fin");
-    wq_.pop_front();
+    wq_.pop();
     if(do_close_)
         impl().ws_.async_close(cr_, strand_.wrap(std::bind(
             &BaseWSPeer::on_close, impl().shared_from_this(),
@@ -25,6 +25,7 @@
 #include <stoxum/protocol/SystemParameters.h>
 #include <stoxum/json/to_string.h>
 #include <boost/algorithm/string.hpp>
+#include <sstream>
 
 namespace ripple {
 
@@ -118,4 +119,82 @@ void HTTPReply (
     output ("\r\n");
 }
 
+void HTTPBinaryReply (std::string const& contentType,
+    Slice const& content, Json::Output const& output, beast::Journal j)
+{
+    JLOG (j.trace())
+        << "HTTP Reply 200 binary " << content.size() << " bytes";
+
+    output ("HTTP/1.1 200 OK\r\n");
+    output (getHTTPHeaderTimestamp ());
+
+    output ("Connection: Keep-Alive\r\n"
+            "Content-Length: ");
+    output (std::to_string(content.size ()));
+    output ("\r\n"
+            "Content-Type: ");
+    output (contentType);
+
+    output ("\r\n"
+            "Server: " + systemName () + "-json-rpc/");
+    output (BuildInfo::getFullVersionString ());
+    output ("\r\n"
+            "\r\n");
+    output (beast::string_view (
+        reinterpret_cast<char const*> (content.data()), content.size()));
+}
+
+HTTPChunkedReply::HTTPChunkedReply (
+    Json::Output const& output, beast::Journal j)
+    : output_ (output)
+{
+    JLOG (j.trace())
+        << "HTTP Reply 200 chunked";
+
+    output_ ("HTTP/1.1 200 OK\r\n");
+    output_ (getHTTPHeaderTimestamp ());
+
+    output_ ("Connection: Keep-Alive\r\n"
+             "Transfer-Encoding: chunked\r\n"
+             "Content-Type: application/json; charset=UTF-8\r\n");
+
+    output_ ("Server: " + systemName () + "-json-rpc/");
+    output_ (BuildInfo::getFullVersionString ());
+    output_ ("\r\n"
+             "\r\n");
+
+    buffer_.reserve (chunkSize);
+}
+
+void
+HTTPChunkedReply::write (beast::string_view const& data)
+{
+    buffer_.append (data.data(), data.size());
+    size_ += data.size();
+    if (buffer_.size() >= chunkSize)
+        flush ();
+}
+
+void
+HTTPChunkedReply::flush ()
+{
+    if (buffer_.empty())
+        return;
+
+    std::stringstream ss;
+    ss << std::hex << buffer_.size() << "\r\n";
+    output_ (ss.str());
+    output_ (buffer_);
+    output_ ("\r\n");
+    buffer_.clear();
+}
+
+void
+HTTPChunkedReply::finish ()
+{
+    flush ();
+    output_ ("0\r\n"
+             "\r\n");
+}
+
 } // ripple
@@ -21,6 +21,7 @@
 #define RIPPLE_SERVER_JSONRPCUTIL_H_INCLUDED
 
 #include <stoxum/json/json_value.h>
+#include <stoxum/basics/Slice.h>
 #include <stoxum/json/Output.h>
 
 namespace ripple {
@@ -28,6 +29,51 @@ namespace ripple {
 void HTTPReply (
     int nStatus, std::string const& strMsg, Json::Output const&, beast::Journal j);
 
+/** Send a successful reply whose body is not JSON. */
+void HTTPBinaryReply (std::string const& contentType,
+    Slice const& content, Json::Output const&, beast::Journal j);
+
+/** A successful reply whose body is sent as it is produced.
+
+    The status line and headers are sent on construction, and the body
+    follows with chunked transfer encoding, one chunk each time enough
+    of it has been buffered. Only HTTP/1.1 clients accept this.
+*/
+class HTTPChunkedReply
+{
+public:
+    // Body bytes buffered before a chunk is sent
+    static std::size_t constexpr chunkSize = 16 * 1024;
+
+    HTTPChunkedReply (Json::Output const&, beast::Journal j);
+
+    HTTPChunkedReply (HTTPChunkedReply const&) = delete;
+    HTTPChunkedReply& operator= (HTTPChunkedReply const&) = delete;
+
+    /** Append to the body. */
+    void
+    write (beast::string_view const& data);
+
+    /** Send the rest of the body and end the reply. */
+    void
+    finish ();
+
+    /** The size of the body written so far. */
+    std::size_t
+    size () const
+    {
+        return size_;
+    }
+
+private:
+    void
+    flush ();
+
+    Json::Output output_;
+    std::string buffer_;
+    std::size_t size_ = 0;
+};
+
 } // ripple
 
 #endif
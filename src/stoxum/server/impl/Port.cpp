@@ -233,6 +233,28 @@ parse_Port (ParsedPort& port, Section const& section, std::ostream& log)
         }
     }
 
+    {
+        auto const result = section.find("send_queue_bytes");
+        if (result.second)
+        {
+            try
+            {
+                port.ws_queue_bytes =
+                    beast::lexicalCastThrow<std::size_t>(result.first);
+
+                if (port.ws_queue_bytes == 0)
+                    Throw<std::exception>();
+            }
+            catch (std::exception const&)
+            {
+                log <<
+                    "Invalid value '" << result.first << "' for key " <<
+                    "'send_queue_bytes' in [" << section.name() << "]";
+                Rethrow();
+            }
+        }
+    }
+
     populate (section, "admin", log, port.admin_ip, true, {});
     populate (section, "secure_gateway", log, port.secure_gateway_ip, false,
         port.admin_ip.get_value_or({}));
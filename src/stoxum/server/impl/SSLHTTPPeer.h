@@ -159,7 +159,7 @@ do_request()
     if(what.response)
         return this->write(what.response, what.keep_alive);
     // legacy
-    this->handler_.onRequest(this->session());
+    this->dispatch();
 }
 
 template<class Handler>
@@ -0,0 +1,165 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2017 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+
+#ifndef RIPPLE_SERVER_WSQUEUE_H_INCLUDED
+#define RIPPLE_SERVER_WSQUEUE_H_INCLUDED
+
+#include <stoxum/server/WSSession.h>
+#include <boost/circular_buffer.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+
+namespace ripple {
+
+/** The messages waiting to be written to a WebSocket.
+
+    The front message is the one being written. The queue is bounded
+    both by a number of messages and by the bytes they hold, and a
+    message that is superseded by a newer one of the same kind is
+    dropped before it is written, so that a slow client receives the
+    latest status instead of a backlog of stale ones.
+*/
+class WSQueue
+{
+public:
+    struct Stats
+    {
+        // Messages and bytes written
+        std::uint64_t sent = 0;
+        std::uint64_t sentBytes = 0;
+
+        // Messages dropped because a newer one superseded them
+        std::uint64_t coalesced = 0;
+
+        // Most bytes held at once
+        std::size_t peakBytes = 0;
+    };
+
+    WSQueue(std::size_t maxMessages, std::size_t maxBytes)
+        : q_(maxMessages + 1)
+        , maxBytes_(maxBytes)
+    {
+    }
+
+    WSQueue(WSQueue const&) = delete;
+    WSQueue& operator=(WSQueue const&) = delete;
+
+    /** Add a message to the back of the queue.
+
+        @return `false` if the queue is full, in which case the
+                message is not added.
+    */
+    bool
+    push(std::shared_ptr<WSMsg> m)
+    {
+        if (! m->kind().empty())
+        {
+            // The front is being written, so it is never dropped
+            for (auto i = q_.size(); i > 1; --i)
+            {
+                auto const& old = q_[i - 1];
+                if (old->kind() == m->kind())
+                {
+                    bytes_ -= old->size();
+                    q_.erase(q_.begin() + (i - 1));
+                    ++stats_.coalesced;
+                    break;
+                }
+            }
+        }
+
+        if (q_.full() || (! q_.empty() && bytes_ + m->size() > maxBytes_))
+            return false;
+
+        bytes_ += m->size();
+        stats_.peakBytes = std::max(stats_.peakBytes, bytes_);
+        q_.push_back(std::move(m));
+        return true;
+    }
+
+    /** The message being written. */
+    WSMsg&
+    front()
+    {
+        assert(! q_.empty());
+        return *q_.front();
+    }
+
+    /** Remove the front message, once it is written. */
+    void
+    pop()
+    {
+        assert(! q_.empty());
+        auto const n = q_.front()->size();
+        bytes_ -= n;
+        ++stats_.sent;
+        stats_.sentBytes += n;
+        q_.pop_front();
+    }
+
+    /** Remove every message except the one being written. */
+    void
+    drop_pending()
+    {
+        while (q_.size() > 1)
+        {
+            bytes_ -= q_.back()->size();
+            q_.pop_back();
+        }
+    }
+
+    bool
+    empty() const
+    {
+        return q_.empty();
+    }
+
+    std::size_t
+    size() const
+    {
+        return q_.size();
+    }
+
+    /** The bytes held by queued messages. */
+    std::size_t
+    bytes() const
+    {
+        return bytes_;
+    }
+
+    Stats const&
+    stats() const
+    {
+        return stats_;
+    }
+
+private:
+    boost::circular_buffer_space_optimized<std::shared_ptr<WSMsg>> q_;
+    std::size_t maxBytes_;
+    std::size_t bytes_ = 0;
+    Stats stats_;
+};
+
+} // ripple
+
+#endif
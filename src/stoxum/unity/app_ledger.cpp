@@ -22,6 +22,7 @@
 #include <stoxum/app/ledger/AcceptedLedger.cpp>
 #include <stoxum/app/ledger/AcceptedLedgerTx.cpp>
 #include <stoxum/app/ledger/AccountStateSF.cpp>
+#include <stoxum/app/ledger/BookIndex.cpp>
 #include <stoxum/app/ledger/BookListeners.cpp>
 #include <stoxum/app/ledger/ConsensusTransSetSF.cpp>
 #include <stoxum/app/ledger/Ledger.cpp>
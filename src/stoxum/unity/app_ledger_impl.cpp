@@ -24,8 +24,10 @@
 #include <stoxum/app/ledger/impl/InboundTransactions.cpp>
 #include <stoxum/app/ledger/impl/LedgerCleaner.cpp>
 #include <stoxum/app/ledger/impl/LedgerMaster.cpp>
+#include <stoxum/app/ledger/impl/LedgerSaveQueue.cpp>
 #include <stoxum/app/ledger/impl/LocalTxs.cpp>
 #include <stoxum/app/ledger/impl/OpenLedger.cpp>
 #include <stoxum/app/ledger/impl/LedgerToJson.cpp>
+#include <stoxum/app/ledger/impl/LedgerVerifier.cpp>
 #include <stoxum/app/ledger/impl/TransactionAcquire.cpp>
 #include <stoxum/app/ledger/impl/TransactionMaster.cpp>
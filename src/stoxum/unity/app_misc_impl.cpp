@@ -19,6 +19,7 @@
 
 #include <BeastConfig.h>
 
+#include <stoxum/app/misc/impl/AccountTxIndex.cpp>
 #include <stoxum/app/misc/impl/AccountTxPaging.cpp>
 #include <stoxum/app/misc/impl/AmendmentTable.cpp>
 #include <stoxum/app/misc/impl/LoadFeeTrack.cpp>
@@ -40,6 +40,7 @@
 #include <stoxum/app/tx/impl/SetSignerList.cpp>
 #include <stoxum/app/tx/impl/SetTrust.cpp>
 #include <stoxum/app/tx/impl/SignerEntries.cpp>
+#include <stoxum/app/tx/impl/SpeculativeApply.cpp>
 #include <stoxum/app/tx/impl/Taker.cpp>
 #include <stoxum/app/tx/impl/ApplyContext.cpp>
 #include <stoxum/app/tx/impl/Transactor.cpp>
@@ -54,6 +54,7 @@
 #include <stoxum/rpc/handlers/LedgerEntry.cpp>
 #include <stoxum/rpc/handlers/LedgerHeader.cpp>
 #include <stoxum/rpc/handlers/LedgerRequest.cpp>
+#include <stoxum/rpc/handlers/LedgerVerify.cpp>
 #include <stoxum/rpc/handlers/LogLevel.cpp>
 #include <stoxum/rpc/handlers/LogRotate.cpp>
 #include <stoxum/rpc/handlers/NoRippleCheck.cpp>
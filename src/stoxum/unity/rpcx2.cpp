@@ -55,8 +55,11 @@
 #include <stoxum/rpc/impl/Handler.cpp>
 #include <stoxum/rpc/impl/LegacyPathFind.cpp>
 #include <stoxum/rpc/impl/Role.cpp>
+#include <stoxum/rpc/impl/RPCAdmission.cpp>
 #include <stoxum/rpc/impl/RPCHandler.cpp>
 #include <stoxum/rpc/impl/RPCHelpers.cpp>
+#include <stoxum/rpc/impl/RPCResponseCache.cpp>
+#include <stoxum/rpc/impl/RPCStats.cpp>
 #include <stoxum/rpc/impl/ServerHandlerImp.cpp>
 #include <stoxum/rpc/impl/Status.cpp>
 #include <stoxum/rpc/impl/TransactionSign.cpp>
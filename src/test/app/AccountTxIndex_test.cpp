@@ -0,0 +1,230 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2017 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <stoxum/app/misc/AccountTxIndex.h>
+#include <stoxum/beast/unit_test.h>
+#include <stoxum/beast/utility/temp_dir.h>
+#include <stoxum/protocol/digest.h>
+#include <stoxum/protocol/SecretKey.h>
+#include <algorithm>
+
+namespace ripple {
+namespace test {
+
+class AccountTxIndex_test : public beast::unit_test::suite
+{
+    using Posting = AccountTxIndex::Posting;
+    using Marker = AccountTxIndex::Marker;
+
+    beast::Journal journal;
+    AccountID alice_;
+    AccountID bob_;
+
+    static
+    uint256
+    txID (AccountID const& account, std::uint32_t ledger, std::uint32_t seq)
+    {
+        return sha512Half (account, ledger, seq);
+    }
+
+    // Postings for ledgers [first, last], each with `perLedger`
+    // transactions that alternate between alice and bob
+    std::vector<Posting>
+    postings (std::uint32_t first, std::uint32_t last,
+        std::uint32_t perLedger)
+    {
+        std::vector<Posting> v;
+        for (auto ledger = first; ledger <= last; ++ledger)
+        {
+            for (std::uint32_t seq = 0; seq < perLedger; ++seq)
+            {
+                auto const& account = (seq % 2) ? bob_ : alice_;
+                v.push_back ({ account, ledger, seq,
+                    txID (account, ledger, seq) });
+            }
+        }
+        return v;
+    }
+
+    std::vector<Marker>
+    query (AccountTxIndex const& index, AccountID const& account,
+        std::uint32_t minLedger, std::uint32_t maxLedger, bool forward,
+            boost::optional<Marker> const& start = boost::none,
+                std::size_t limit = 1000000)
+    {
+        std::vector<Marker> v;
+        index.forEach (account, minLedger, maxLedger, forward, start,
+            [&](Posting const& p)
+            {
+                BEAST_EXPECT(p.account == account);
+                BEAST_EXPECT(p.txID == txID (account, p.ledgerSeq, p.txnSeq));
+                v.emplace_back (p.ledgerSeq, p.txnSeq);
+                return v.size() < limit;
+            });
+        return v;
+    }
+
+    // The expected postings of alice in [minLedger, maxLedger]
+    static
+    std::vector<Marker>
+    expected (std::uint32_t minLedger, std::uint32_t maxLedger,
+        std::uint32_t perLedger, bool forward)
+    {
+        std::vector<Marker> v;
+        for (auto ledger = minLedger; ledger <= maxLedger; ++ledger)
+            for (std::uint32_t seq = 0; seq < perLedger; seq += 2)
+                v.emplace_back (ledger, seq);
+        if (! forward)
+            std::reverse (v.begin(), v.end());
+        return v;
+    }
+
+    AccountTxIndex::Setup
+    setup (beast::temp_dir const& dir)
+    {
+        AccountTxIndex::Setup setup;
+        setup.path = dir.path();
+        setup.flushPostings = 100;
+        setup.maxSegments = 3;
+        return setup;
+    }
+
+    void
+    testQuery()
+    {
+        testcase ("query");
+
+        beast::temp_dir dir;
+        AccountTxIndex index (setup (dir), nullptr, journal);
+        index.open (nullptr);
+        BEAST_EXPECT(index.enabled());
+
+        // Spread the postings over the table and several segments
+        for (std::uint32_t ledger = 1; ledger <= 50; ++ledger)
+            index.insert (postings (ledger, ledger, 10));
+        BEAST_EXPECT(index.segments() > 0);
+        BEAST_EXPECT(index.segments() <= 3);
+
+        BEAST_EXPECT(query (index, alice_, 1, 50, true) ==
+            expected (1, 50, 10, true));
+        BEAST_EXPECT(query (index, alice_, 1, 50, false) ==
+            expected (1, 50, 10, false));
+        BEAST_EXPECT(query (index, alice_, 10, 20, true) ==
+            expected (10, 20, 10, true));
+        BEAST_EXPECT(query (index, alice_, 10, 20, false) ==
+            expected (10, 20, 10, false));
+        BEAST_EXPECT(query (index, alice_, 60, 70, true).empty());
+        BEAST_EXPECT(query (index, AccountID{}, 1, 50, true).empty());
+
+        // Page through with markers
+        for (bool const forward : { true, false })
+        {
+            std::vector<Marker> all;
+            boost::optional<Marker> marker;
+            for (;;)
+            {
+                auto page = query (index, alice_, 5, 45, forward, marker, 8);
+                if (page.size() < 8)
+                {
+                    all.insert (all.end(), page.begin(), page.end());
+                    break;
+                }
+                // The last posting starts the next page
+                marker = page.back();
+                all.insert (all.end(), page.begin(), page.end() - 1);
+            }
+            BEAST_EXPECT(all == expected (5, 45, 10, forward));
+        }
+
+        // Inserting a ledger again adds nothing
+        index.insert (postings (20, 20, 10));
+        index.flush();
+        BEAST_EXPECT(query (index, alice_, 1, 50, true) ==
+            expected (1, 50, 10, true));
+    }
+
+    void
+    testReopen()
+    {
+        testcase ("reopen");
+
+        beast::temp_dir dir;
+        {
+            AccountTxIndex index (setup (dir), nullptr, journal);
+            index.open (nullptr);
+            index.insert (postings (1, 30, 10));
+            index.deleteBefore (5);
+            // Only in the log
+            index.insert (postings (31, 32, 10));
+        }
+        {
+            AccountTxIndex index (setup (dir), nullptr, journal);
+            index.open (nullptr);
+            BEAST_EXPECT(query (index, alice_, 1, 100, true) ==
+                expected (5, 32, 10, true));
+            BEAST_EXPECT(query (index, bob_, 1, 100, false).size() ==
+                28 * 5);
+
+            // Merging drops the deleted postings
+            index.deleteBefore (20);
+            for (std::uint32_t ledger = 33; ledger <= 80; ++ledger)
+                index.insert (postings (ledger, ledger, 10));
+            index.flush();
+            BEAST_EXPECT(index.segments() <= 3);
+            BEAST_EXPECT(query (index, alice_, 1, 100, true) ==
+                expected (20, 80, 10, true));
+        }
+        {
+            AccountTxIndex index (setup (dir), nullptr, journal);
+            index.open (nullptr);
+            BEAST_EXPECT(query (index, alice_, 1, 100, false) ==
+                expected (20, 80, 10, false));
+        }
+    }
+
+    void
+    testDisabled()
+    {
+        testcase ("disabled");
+
+        AccountTxIndex index ({}, nullptr, journal);
+        index.open (nullptr);
+        BEAST_EXPECT(! index.enabled());
+        index.insert (postings (1, 1, 10));
+        BEAST_EXPECT(query (index, alice_, 1, 10, true).empty());
+    }
+
+public:
+    void
+    run() override
+    {
+        alice_ = calcAccountID (randomKeyPair (KeyType::secp256k1).first);
+        bob_ = calcAccountID (randomKeyPair (KeyType::secp256k1).first);
+
+        testQuery();
+        testReopen();
+        testDisabled();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(AccountTxIndex,app,ripple);
+
+} // test
+} // ripple
@@ -0,0 +1,101 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2017 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+
+#include <BeastConfig.h>
+#include <stoxum/app/ledger/BookIndex.h>
+#include <stoxum/protocol/Indexes.h>
+#include <stoxum/beast/unit_test.h>
+#include <test/jtx.h>
+
+namespace ripple {
+namespace test {
+
+class BookIndex_test : public beast::unit_test::suite
+{
+    // The quality directories of a book, as seen through a view
+    static
+    std::vector<uint256>
+    qualities (ReadView const& view, Book const& book)
+    {
+        std::vector<uint256> v;
+        auto const base = getBookBase (book);
+        auto const last = getQualityNext (base);
+        for (auto key = view.succ (base, last); key;
+                key = view.succ (*key, last))
+            v.push_back (*key);
+        return v;
+    }
+
+public:
+    void
+    run() override
+    {
+        using namespace jtx;
+        Env env (*this);
+
+        auto const gw = Account ("gateway");
+        auto const alice = Account ("alice");
+        auto const USD = gw["USD"];
+        env.fund (STM(100000), gw, alice);
+        env.trust (USD(1000), alice);
+        env.close();
+
+        Book const book (xrpIssue(), USD.issue());
+        BEAST_EXPECT(BookIndex::covers (getBookBase (book),
+            getQualityNext (getBookBase (book))));
+        BEAST_EXPECT(! BookIndex::covers (getBookBase (book),
+            getBookBase (book)));
+
+        env (offer (gw, STM(100), USD(10)));
+        env (offer (gw, STM(100), USD(20)));
+        env (offer (gw, STM(100), USD(30)));
+        env.close();
+
+        auto const closed = qualities (*env.closed(), book);
+        BEAST_EXPECT(closed.size() == 3);
+        BEAST_EXPECT(std::is_sorted (closed.begin(), closed.end()));
+        // Scanning again is answered from the index
+        BEAST_EXPECT(qualities (*env.closed(), book) == closed);
+        BEAST_EXPECT(qualities (*env.current(), book) == closed);
+
+        // Starting inside the book
+        auto const last = getQualityNext (getBookBase (book));
+        BEAST_EXPECT(env.closed()->succ (closed[0], last) == closed[1]);
+        BEAST_EXPECT(! env.closed()->succ (closed[2], last));
+
+        // Changes on top of the closed ledger are merged in
+        env (offer (gw, STM(100), USD(40)));
+        auto const open = qualities (*env.current(), book);
+        BEAST_EXPECT(open.size() == 4);
+        BEAST_EXPECT(qualities (*env.closed(), book) == closed);
+
+        // Consuming the best quality removes its directory
+        env (offer (alice, USD(40), STM(100)));
+        env.close();
+        BEAST_EXPECT(qualities (*env.closed(), book) == closed);
+        BEAST_EXPECT(qualities (*env.current(), book) == closed);
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(BookIndex,app,ripple);
+
+} // test
+} // ripple
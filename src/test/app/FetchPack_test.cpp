@@ -0,0 +1,127 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2017 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <stoxum/app/ledger/LedgerMaster.h>
+#include <stoxum/protocol/HashPrefix.h>
+#include <stoxum/beast/unit_test.h>
+#include <test/jtx.h>
+
+namespace ripple {
+
+class FetchPack_test : public beast::unit_test::suite
+{
+    // Build the reply the way makeFetchPack did before deltas were
+    // precomputed, appending straight into the message.
+    static
+    void
+    appendDirect (
+        protocol::TMGetObjectByHash& reply,
+        Ledger const& haveLedger,
+        Ledger const& wantLedger)
+    {
+        std::uint32_t const lSeq = wantLedger.info().seq;
+
+        auto fpAppender = [&reply, lSeq](
+            SHAMapHash const& hash,
+            const Blob& blob)
+        {
+            protocol::TMIndexedObject& newObj = * (reply.add_objects ());
+            newObj.set_ledgerseq (lSeq);
+            newObj.set_hash (hash.as_uint256().begin (), 256 / 8);
+            newObj.set_data (&blob[0], blob.size ());
+        };
+
+        protocol::TMIndexedObject& newObj = *reply.add_objects ();
+        newObj.set_hash (wantLedger.info().hash.data(), 256 / 8);
+        Serializer s (256);
+        s.add32 (HashPrefix::ledgerMaster);
+        addRaw(wantLedger.info(), s);
+        newObj.set_data (s.getDataPtr (), s.getLength ());
+        newObj.set_ledgerseq (lSeq);
+
+        wantLedger.stateMap().getFetchPack (
+            &haveLedger.stateMap(), true, 16384, fpAppender);
+
+        if (wantLedger.info().txHash.isNonZero ())
+            wantLedger.txMap().getFetchPack (
+                nullptr, true, 512, fpAppender);
+    }
+
+    static
+    protocol::TMGetObjectByHash
+    emptyReply ()
+    {
+        protocol::TMGetObjectByHash reply;
+        reply.set_query (false);
+        reply.set_seq (7);
+        reply.set_ledgerhash (std::string (32, 'x'));
+        reply.set_type (protocol::TMGetObjectByHash::otFETCH_PACK);
+        return reply;
+    }
+
+public:
+    void
+    run() override
+    {
+        using namespace test::jtx;
+        Env env {*this};
+        Account const alice ("alice");
+        Account const bob ("bob");
+
+        env.fund (STM(10000), alice, bob);
+        env.close();
+        for (int i = 0; i < 3; ++i)
+        {
+            env (pay (alice, bob, STM(10)));
+            env (pay (bob, alice, STM(5)));
+            env.close();
+        }
+
+        auto& lm = env.app().getLedgerMaster();
+        auto const last = env.closed()->info().seq;
+
+        protocol::TMGetObjectByHash direct = emptyReply ();
+        protocol::TMGetObjectByHash merged = emptyReply ();
+
+        // Walk back through several ledgers, as makeFetchPack does
+        for (auto seq = last; seq > last - 3; --seq)
+        {
+            auto const have = lm.getLedgerBySeq (seq);
+            auto const want = lm.getLedgerBySeq (seq - 1);
+            if (! BEAST_EXPECT(have && want))
+                return;
+
+            appendDirect (direct, *have, *want);
+
+            auto const delta = makeFetchPackDelta (*have, *want);
+            BEAST_EXPECT(! delta->empty());
+            BEAST_EXPECT(merged.MergeFromString (*delta));
+        }
+
+        BEAST_EXPECT(merged.objects_size () > 3);
+        BEAST_EXPECT(merged.objects_size () == direct.objects_size ());
+        BEAST_EXPECT(merged.SerializeAsString () ==
+            direct.SerializeAsString ());
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(FetchPack,app,ripple);
+
+} // ripple
@@ -0,0 +1,217 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2017 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+
+#include <BeastConfig.h>
+#include <stoxum/protocol/JsonFields.h>
+#include <stoxum/beast/unit_test.h>
+#include <test/jtx.h>
+#include <test/jtx/PathSet.h>
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <vector>
+
+namespace ripple {
+namespace test {
+
+/*  Measures the payment engine on a large synthetic ledger.
+
+    The ledger has many funded accounts holding a gateway's USD, a deep
+    order book selling USD for STM, and a long chain of accounts that
+    ripple a currency through each other. Payments through the chain
+    and the book, offers crossing the book and ripple_path_find are
+    each timed, and their throughput and latency reported.
+
+    Arguments: accounts, book depth and chain length, e.g.
+        --unittest=FlowBench --unittest-arg="1000 500 20"
+*/
+class FlowBench_test : public beast::unit_test::suite
+{
+    using clock_type = std::chrono::steady_clock;
+
+    std::size_t accounts_ = 1000;
+    std::size_t depth_ = 500;
+    std::size_t chain_ = 20;
+
+    // Transactions between ledger closes while timing
+    static std::size_t constexpr perLedger = 50;
+
+    // Runs f for each of n operations and reports the results. Ledgers
+    // are closed between batches, outside the timings.
+    template <class F>
+    void
+    measure (jtx::Env& env, std::string const& name, std::size_t n, F&& f)
+    {
+        std::vector<std::chrono::microseconds> latency;
+        latency.reserve (n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            auto const start = clock_type::now();
+            f (i);
+            latency.push_back (std::chrono::duration_cast<
+                std::chrono::microseconds> (clock_type::now() - start));
+            if ((i + 1) % perLedger == 0)
+                env.close();
+        }
+        env.close();
+
+        if (latency.empty())
+            return;
+
+        std::chrono::microseconds total {0};
+        for (auto const& l : latency)
+            total += l;
+        std::sort (latency.begin(), latency.end());
+
+        log << name << ": " << n << " in " <<
+            total.count() / 1000 << "ms, " <<
+            (total.count() ? n * 1000000 / total.count() : 0) << "/s, " <<
+            "p50 " << latency[n / 2].count() << "us, " <<
+            "p99 " << latency[n * 99 / 100].count() << "us, " <<
+            "max " << latency.back().count() << "us" << std::endl;
+    }
+
+public:
+    void
+    run() override
+    {
+        if (! arg().empty())
+        {
+            std::istringstream args (arg());
+            args >> accounts_ >> depth_ >> chain_;
+        }
+        log << "FlowBench: " << accounts_ << " accounts, book depth " <<
+            depth_ << ", chain length " << chain_ << std::endl;
+
+        using namespace jtx;
+        Env env (*this);
+
+        auto const gw = Account ("gateway");
+        auto const bob = Account ("bob");
+        auto const USD = gw["USD"];
+        env.fund (STM(100000000), gw, bob);
+        env.trust (USD(100000000), bob);
+        env.close();
+
+        auto const setupStart = clock_type::now();
+
+        // Accounts holding USD and STM
+        std::vector<Account> users;
+        users.reserve (accounts_);
+        for (std::size_t i = 0; i < accounts_; ++i)
+        {
+            users.emplace_back ("user" + std::to_string (i));
+            env.fund (STM(100000), users.back());
+            env.trust (USD(1000000), users.back());
+            env (pay (gw, users.back(), USD(10000)));
+            if ((i + 1) % (perLedger / 3) == 0)
+                env.close();
+        }
+        env.close();
+
+        // Makers selling USD for STM at increasing prices
+        std::vector<Account> makers;
+        for (std::size_t i = 0; i < 10; ++i)
+        {
+            makers.emplace_back ("maker" + std::to_string (i));
+            env.fund (STM(100000000), makers.back());
+            env.trust (USD(100000000), makers.back());
+            env (pay (gw, makers.back(), USD(10000000)));
+        }
+        env.close();
+        for (std::size_t i = 0; i < depth_; ++i)
+        {
+            env (offer (makers[i % makers.size()],
+                STM(100 + i), USD(100)));
+            if ((i + 1) % perLedger == 0)
+                env.close();
+        }
+        env.close();
+
+        // Each account in the chain holds the previous one's CHN
+        std::vector<Account> chain;
+        for (std::size_t i = 0; i < chain_; ++i)
+        {
+            chain.emplace_back ("chain" + std::to_string (i));
+            env.fund (STM(100000), chain.back());
+        }
+        env.close();
+        for (std::size_t i = 1; i < chain.size(); ++i)
+            env.trust (chain[i - 1]["CHN"](100000000), chain[i]);
+        env.close();
+
+        log << "setup: " << std::chrono::duration_cast<
+            std::chrono::milliseconds> (clock_type::now() - setupStart).count()
+                << "ms" << std::endl;
+
+        if (chain.size() > 2)
+        {
+            Path path;
+            for (std::size_t i = 1; i + 1 < chain.size(); ++i)
+                path.push_back (chain[i]);
+            auto const paths = PathSet (path).json();
+
+            measure (env, "payment through chain", accounts_,
+                [&](std::size_t)
+                {
+                    env (pay (chain.front(), chain.back(),
+                        chain.back()["CHN"](1)), json (paths),
+                            txflags (tfNoRippleDirect));
+                });
+        }
+
+        measure (env, "payment through book", accounts_,
+            [&](std::size_t i)
+            {
+                env (pay (users[i], bob, USD(10)), path (~USD),
+                    sendmax (STM(200)), txflags (tfNoRippleDirect));
+            });
+
+        measure (env, "offer crossing book", accounts_,
+            [&](std::size_t i)
+            {
+                env (offer (users[i], USD(10), STM(200)));
+            });
+
+        measure (env, "offer placed without crossing", accounts_,
+            [&](std::size_t i)
+            {
+                env (offer (users[i], USD(10), STM(1)));
+            });
+
+        measure (env, "ripple_path_find", std::min<std::size_t> (accounts_, 100),
+            [&](std::size_t i)
+            {
+                Json::Value params;
+                params[jss::source_account] = users[i].human();
+                params[jss::destination_account] = bob.human();
+                params[jss::destination_amount] = USD(10).value().getJson (0);
+                auto const result = env.rpc ("json", "ripple_path_find",
+                    to_string (params))[jss::result];
+                BEAST_EXPECT(result.isMember (jss::alternatives));
+            });
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL(FlowBench,app,ripple);
+
+} // test
+} // ripple
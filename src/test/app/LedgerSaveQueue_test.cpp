@@ -0,0 +1,74 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2017 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <stoxum/app/ledger/LedgerSaveQueue.h>
+#include <stoxum/protocol/JsonFields.h>
+#include <stoxum/beast/unit_test.h>
+#include <test/jtx.h>
+
+namespace ripple {
+namespace test {
+
+class LedgerSaveQueue_test : public beast::unit_test::suite
+{
+public:
+    void
+    run() override
+    {
+        using namespace jtx;
+        Env env (*this);
+
+        Account const alice ("alice");
+        Account const bob ("bob");
+        env.fund (STM(10000), alice, bob);
+        env.close();
+
+        auto const first = env.closed()->info().seq + 1;
+        // More ledgers than one batch holds
+        auto const count = LedgerSaveQueue::batchSize + 4;
+        std::vector<uint256> hashes;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            env (pay (alice, bob, STM(1)));
+            env.close();
+            hashes.push_back (env.closed()->info().hash);
+        }
+
+        auto& app = env.app();
+        auto& queue = app.getLedgerSaveQueue();
+        queue.flush();
+        BEAST_EXPECT(queue.size() == 0);
+        BEAST_EXPECT(! queue.backlogged());
+
+        for (std::size_t i = 0; i < count; ++i)
+            BEAST_EXPECT(getHashByIndex (first + i, app) == hashes[i]);
+
+        auto const result = env.rpc ("json", "account_tx",
+            "{\"account\": \"" + alice.human() + "\", "
+            "\"ledger_index_min\": " + std::to_string (first) + ", "
+            "\"ledger_index_max\": -1}")[jss::result];
+        BEAST_EXPECT(result[jss::transactions].size() == count);
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(LedgerSaveQueue,app,ripple);
+
+} // test
+} // ripple
@@ -4550,6 +4550,83 @@ public:
         BEAST_EXPECT (++it == offers.end());
     }
 
+    void testOfferNotCrossed (FeatureBitset features)
+    {
+        // Offers between STM and a currency that cross nothing skip the
+        // payment engine.  Compare the ledger they leave with the one left
+        // by Taker offer crossing.
+        testcase ("Offer Not Crossed");
+
+        using namespace jtx;
+
+        auto const gw = Account {"gateway"};
+        auto const alice = Account {"alice"};
+        auto const bob = Account {"bob"};
+        auto const USD = gw["USD"];
+
+        struct Case
+        {
+            bool book;
+            STAmount takerPays;
+            STAmount takerGets;
+            std::uint32_t flags;
+            double xferRate;
+        };
+
+        std::vector<Case> const cases
+        {
+            { false, USD(100), STM(100), 0,           1.0  },
+            { false, STM(100), USD(100), 0,           1.0  },
+            { true,  USD(100), STM(90),  0,           1.0  },
+            { true,  USD(100), STM(100), tfPassive,   1.0  },
+            { true,  USD(100), STM(100), 0,           1.0  },
+            { true,  USD(100), STM(90),  tfFillOrKill, 1.0 },
+            { true,  USD(100), STM(90),  tfSell,      1.0  },
+            { true,  USD(100), STM(90),  0,           1.25 },
+            { true,  USD(100), STM(100), tfPassive,   1.25 },
+        };
+
+        auto run = [&](FeatureBitset fs, Case const& c)
+        {
+            Env env {*this, fs};
+            env.fund (STM(10000), gw, alice, bob);
+            if (c.xferRate != 1.0)
+                env (rate (gw, c.xferRate));
+            env.trust (USD(1000), alice, bob);
+            env (pay (gw, alice, USD(500)));
+            env.close();
+
+            if (c.book)
+                env (offer (alice, STM(100), USD(100)));
+            env.close();
+
+            env (offer (bob, c.takerPays, c.takerGets),
+                txflags (c.flags), ter (std::ignore));
+            TER const result = env.ter();
+
+            std::vector<STAmount> state;
+            for (auto const& acct : {alice, bob})
+            {
+                state.push_back (env.balance (acct));
+                state.push_back (env.balance (acct, USD));
+                for (auto const& sle : offersOnAccount (env, acct))
+                {
+                    state.push_back ((*sle)[sfTakerPays]);
+                    state.push_back ((*sle)[sfTakerGets]);
+                }
+            }
+            return std::make_pair (result, state);
+        };
+
+        for (auto const& c : cases)
+        {
+            auto const flowR = run (features | featureFlowCross, c);
+            auto const takerR = run (features - featureFlowCross, c);
+            BEAST_EXPECT(flowR.first == takerR.first);
+            BEAST_EXPECT(flowR.second == takerR.second);
+        }
+    }
+
     void testAll(FeatureBitset features)
     {
         testCanceledOffer(features);
@@ -4623,6 +4700,7 @@ public:
         testAll(all        - f1373            );
         testAll(all                - flowCross);
         testAll(all                           );
+        testOfferNotCrossed (all);
     }
 };
 
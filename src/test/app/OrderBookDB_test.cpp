@@ -0,0 +1,88 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2017 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+
+#include <BeastConfig.h>
+#include <stoxum/app/ledger/AcceptedLedger.h>
+#include <stoxum/app/ledger/OrderBookDB.h>
+#include <stoxum/beast/unit_test.h>
+#include <test/jtx.h>
+
+namespace ripple {
+namespace test {
+
+class OrderBookDB_test : public beast::unit_test::suite
+{
+public:
+    void
+    run() override
+    {
+        using namespace jtx;
+        Env env (*this);
+
+        auto const gw = Account ("gateway");
+        auto const USD = gw["USD"];
+        env.fund (STM(100000), gw);
+        env.close();
+
+        auto& db = env.app().getOrderBookDB();
+        db.setup (env.closed());
+
+        // Publish the last closed ledger to the books
+        auto const publish = [&]
+        {
+            AcceptedLedger const accepted (env.closed(),
+                env.app().accountIDCache(), env.app().logs());
+            db.applyLedger (accepted);
+        };
+
+        auto const seq = env.seq (gw);
+        env (offer (gw, USD(10), STM(100)));
+        env.close();
+        publish();
+        BEAST_EXPECT(db.getBookSize (USD.issue()) == 1);
+        BEAST_EXPECT(db.isBookToXRP (USD.issue()));
+
+        // Publishing again changes nothing
+        publish();
+        BEAST_EXPECT(db.getBookSize (USD.issue()) == 1);
+
+        // A second quality in the same book
+        env (offer (gw, USD(10), STM(200)));
+        env (offer_cancel (gw, seq));
+        env.close();
+        publish();
+        BEAST_EXPECT(db.getBookSize (USD.issue()) == 1);
+        BEAST_EXPECT(db.isBookToXRP (USD.issue()));
+
+        // Removing the last offer removes the book
+        env (offer_cancel (gw, seq + 1));
+        env.close();
+        publish();
+        BEAST_EXPECT(db.getBookSize (USD.issue()) == 0);
+        BEAST_EXPECT(! db.isBookToXRP (USD.issue()));
+        BEAST_EXPECT(db.getBooksByTakerPays (USD.issue()).empty());
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(OrderBookDB,app,ripple);
+
+} // test
+} // ripple
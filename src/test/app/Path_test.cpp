@@ -31,6 +31,7 @@
 #include <stoxum/rpc/impl/Tuning.h>
 #include <stoxum/rpc/RPCHandler.h>
 #include <test/jtx.h>
+#include <test/jtx/WSClient.h>
 #include <stoxum/beast/unit_test.h>
 #include <chrono>
 #include <condition_variable>
@@ -457,6 +458,48 @@ public:
         BEAST_EXPECT(equal(sa, Account("alice")["USD"](5)));
     }
 
+    void
+    path_find_anytime()
+    {
+        testcase("path find anytime");
+        using namespace jtx;
+        using namespace std::chrono_literals;
+        Env env(*this, envconfig([](std::unique_ptr<Config> cfg)
+            {
+                cfg->PATH_SEARCH_BUDGET = 10s;
+                return cfg;
+            }));
+        auto const gw = Account("gateway");
+        auto const USD = gw["USD"];
+        env.fund(STM(10000), "alice", "bob", gw);
+        env.trust(USD(600), "alice");
+        env.trust(USD(700), "bob");
+        env(pay(gw, "alice", USD(70)));
+        env(pay(gw, "bob", USD(50)));
+        env.close();
+
+        auto wsc = makeWSClient(env.app().config());
+        Json::Value params;
+        params[jss::subcommand] = "create";
+        params[jss::source_account] = Account("alice").human();
+        params[jss::destination_account] = Account("bob").human();
+        params[jss::destination_amount] =
+            Account("bob")["USD"](5).value().getJson(0);
+        auto const created = wsc->invoke("path_find", params);
+        BEAST_EXPECT(created[jss::result][jss::full_reply] == false);
+
+        // Any partial replies come first, then the full reply
+        env.close();
+        auto const full = wsc->findMsg(5s,
+            [](Json::Value const& jv)
+            {
+                return jv[jss::type] == "path_find" &&
+                    jv[jss::full_reply].asBool();
+            });
+        if (BEAST_EXPECT(full))
+            BEAST_EXPECT((*full)[jss::alternatives].size() == 1);
+    }
+
     void
     xrp_to_xrp()
     {
@@ -1360,6 +1403,7 @@ public:
         direct_path_no_intermediary();
         payment_auto_path_find();
         path_find();
+        path_find_anytime();
         path_find_consume_all();
         alternative_path_consume_both();
         alternative_paths_consume_best_transfer();
@@ -28,6 +28,7 @@
 #include <stoxum/protocol/JsonFields.h>
 #include <test/jtx.h>
 #include <test/jtx/PathSet.h>
+#include <chrono>
 
 namespace ripple {
 namespace test {
@@ -1493,5 +1494,73 @@ struct PayStrand_test : public beast::unit_test::suite
 
 BEAST_DEFINE_TESTSUITE(PayStrand, app, ripple);
 
+// Times flow on a cross currency payment that takes many passes over
+// several strands, with transfer fees on both issuers.
+struct PayStrandBench_test : public beast::unit_test::suite
+{
+    void
+    run() override
+    {
+        using namespace jtx;
+        Env env (*this);
+
+        auto const gw1 = Account ("gw1");
+        auto const gw2 = Account ("gw2");
+        auto const alice = Account ("alice");
+        auto const bob = Account ("bob");
+        auto const USD = gw1["USD"];
+        auto const EUR = gw2["EUR"];
+
+        env.fund (STM(1000000), gw1, gw2, alice, bob);
+        env (rate (gw1, 1.1));
+        env (rate (gw2, 1.2));
+        env.trust (USD(1000000), alice);
+        env.trust (EUR(1000000), bob);
+        env (pay (gw1, alice, USD(100000)));
+        env.close();
+
+        // Makers with a few qualities in each book of both paths
+        for (int i = 0; i < 20; ++i)
+        {
+            Account const maker ("maker" + std::to_string (i));
+            env.fund (STM(1000000), maker);
+            env.trust (USD(1000000), maker);
+            env.trust (EUR(1000000), maker);
+            env (pay (gw2, maker, EUR(10000)));
+            for (int q = 0; q < 3; ++q)
+            {
+                env (offer (maker, USD(100 + i + q), EUR(100)));
+                env (offer (maker, USD(100 + i + q), STM(100)));
+                env (offer (maker, STM(100 + i + q), EUR(100)));
+            }
+            env.close();
+        }
+
+        PathSet const paths (
+            Path (EUR.issue()),
+            Path (xrpIssue(), EUR.issue()));
+        auto const j = env.app().logs().journal ("Flow");
+
+        using clock_type = std::chrono::steady_clock;
+        int const runs = 100;
+        auto const start = clock_type::now();
+        for (int i = 0; i < runs; ++i)
+        {
+            PaymentSandbox sb (env.current().get(), tapNONE);
+            auto const r = flow (sb, EUR(3000), alice, bob, paths.paths,
+                false, false, false, false, boost::none,
+                    STAmount (USD(100000)), j);
+            BEAST_EXPECT(r.result() == tesSUCCESS);
+        }
+        auto const elapsed = std::chrono::duration_cast<
+            std::chrono::microseconds> (clock_type::now() - start);
+
+        log << "flow: " << elapsed.count() / runs << "us per payment" <<
+            std::endl;
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL(PayStrandBench, app, ripple);
+
 }  // test
 }  // ripple
@@ -0,0 +1,148 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2017 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+
+#include <BeastConfig.h>
+#include <stoxum/app/paths/Pathfinder.h>
+#include <stoxum/app/paths/RippleLineCache.h>
+#include <stoxum/beast/unit_test.h>
+#include <test/jtx.h>
+
+namespace ripple {
+namespace test {
+
+class RippleLineCache_test : public beast::unit_test::suite
+{
+    // The peer, balance and limit of each line, for comparing caches
+    static
+    std::vector<std::tuple<AccountID, STAmount, STAmount>>
+    lines (RippleLineCache& cache, jtx::Account const& account)
+    {
+        std::vector<std::tuple<AccountID, STAmount, STAmount>> v;
+        for (auto const& line : cache.getRippleLines (account.id()))
+            v.emplace_back (line->getAccountIDPeer(),
+                line->getBalance(), line->getLimit());
+        std::sort (v.begin(), v.end());
+        return v;
+    }
+
+    void
+    testCarry()
+    {
+        testcase ("carry lines");
+
+        using namespace jtx;
+        Env env (*this);
+
+        Account const gw ("gw");
+        Account const alice ("alice");
+        Account const bob ("bob");
+        Account const carol ("carol");
+        Account const dave ("dave");
+        auto const USD = gw["USD"];
+        env.fund (STM(10000), gw, alice, bob, carol, dave);
+        env.close();
+        env.trust (USD(1000), alice, bob, carol, dave);
+        env (pay (gw, alice, USD(100)));
+        env.close();
+
+        auto parent = std::make_shared<RippleLineCache> (env.closed());
+        for (auto const& a : { gw, alice, bob, carol, dave })
+            parent->getRippleLines (a.id());
+
+        // Change alice's line and add one for bob
+        env (pay (alice, bob, USD(10)));
+        env.trust (bob["EUR"](50), carol);
+        env.close();
+
+        RippleLineCache next (env.closed(), *parent);
+        RippleLineCache fresh (env.closed());
+        for (auto const& a : { gw, alice, bob, carol, dave })
+            BEAST_EXPECT(lines (next, a) == lines (fresh, a));
+        BEAST_EXPECT(lines (next, carol).size() == 2);
+
+        // An unchanged account keeps the lines read for the parent,
+        // while a changed one reads them again
+        BEAST_EXPECT(next.getRippleLines (dave.id())[0] ==
+            parent->getRippleLines (dave.id())[0]);
+        BEAST_EXPECT(next.getRippleLines (alice.id())[0] !=
+            parent->getRippleLines (alice.id())[0]);
+    }
+
+    void
+    testPaths()
+    {
+        testcase ("paths");
+
+        using namespace jtx;
+        Env env (*this);
+
+        Account const gw ("gw");
+        Account const alice ("alice");
+        Account const bob ("bob");
+        auto const USD = gw["USD"];
+        env.fund (STM(10000), gw, alice, bob);
+        env.close();
+        env.trust (USD(1000), alice, bob);
+        env (pay (gw, alice, USD(100)));
+        env.close();
+
+        auto const cache = std::make_shared<RippleLineCache> (env.closed());
+
+        // The best paths alice has to send bob an amount
+        auto const search = [&](STAmount const& amount, int level)
+        {
+            Pathfinder pf (cache, alice.id(), bob.id(), USD.currency,
+                boost::none, amount, boost::none, env.app());
+            BEAST_EXPECT(pf.findPaths (level));
+            pf.computePathRanks (4);
+            STPath fullLiquidityPath;
+            return pf.getBestPaths (4, fullLiquidityPath, {},
+                alice.id()).getJson (0);
+        };
+
+        auto const paths = search (USD(10), 7);
+        BEAST_EXPECT(cache->pathMisses() == 1);
+        BEAST_EXPECT(cache->pathHits() == 0);
+
+        // Another amount reuses the paths found
+        BEAST_EXPECT(search (USD(50), 7) == paths);
+        BEAST_EXPECT(cache->pathMisses() == 1);
+        BEAST_EXPECT(cache->pathHits() == 1);
+
+        // Another search level does not
+        search (USD(50), 4);
+        BEAST_EXPECT(cache->pathMisses() == 2);
+        BEAST_EXPECT(cache->pathHits() == 1);
+    }
+
+public:
+    void
+    run() override
+    {
+        testCarry();
+        testPaths();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(RippleLineCache,app,ripple);
+
+} // test
+} // ripple
@@ -0,0 +1,127 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2017 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <stoxum/app/misc/TxQ.h>
+#include <stoxum/app/tx/SpeculativeApply.h>
+#include <stoxum/beast/unit_test.h>
+#include <test/jtx.h>
+#include <test/jtx/envconfig.h>
+
+namespace ripple {
+namespace test {
+
+class SpeculativeApply_test : public beast::unit_test::suite
+{
+    bool
+    sameState (OpenView const& lhs, OpenView const& rhs)
+    {
+        auto iter = rhs.sles.begin();
+        for (auto const& sle : lhs.sles)
+        {
+            if (iter == rhs.sles.end())
+                return false;
+            if (sle->key() != (*iter)->key() ||
+                    sle->getSerializer().peekData() !=
+                        (*iter)->getSerializer().peekData())
+                return false;
+            ++iter;
+        }
+        return iter == rhs.sles.end();
+    }
+
+public:
+    void
+    run() override
+    {
+        using namespace jtx;
+
+        auto cfg = envconfig();
+        // Keep fee escalation out of the way
+        cfg->section("transaction_queue").set(
+            "minimum_txn_in_ledger_standalone", "1000");
+        Env env (*this, std::move(cfg));
+
+        Account const alice ("alice");
+        Account const bob ("bob");
+        Account const carol ("carol");
+        Account const dave ("dave");
+        Account const erin ("erin");
+        Account const frank ("frank");
+        env.fund (STM(10000), alice, bob, carol, dave, erin, frank);
+        env.close();
+
+        auto const aliceSeq = env.seq (alice);
+        auto const frankSeq = env.seq (frank);
+        std::vector<std::shared_ptr<STTx const>> const txs {
+            env.jt (pay (alice, bob, STM(10))).stx,
+            env.jt (pay (carol, dave, STM(20))).stx,
+            // Depends on the first payment through alice's sequence
+            env.jt (pay (alice, carol, STM(30)), seq (aliceSeq + 1)).stx,
+            env.jt (noop (erin)).stx,
+            // Reads bob, written by the first payment
+            env.jt (pay (bob, erin, STM(40))).stx,
+            // Not applied, so always redone serially
+            env.jt (noop (frank), seq (frankSeq + 5)).stx,
+            env.jt (pay (frank, alice, STM(50))).stx,
+        };
+
+        auto& app = env.app();
+        auto const serial = [&](OpenView& view,
+            std::shared_ptr<STTx const> const& tx)
+        {
+            return app.getTxQ().apply (
+                app, view, tx, tapNONE, env.journal);
+        };
+
+        OpenView expected (batch_view, *env.current());
+        std::vector<std::pair<TER, bool>> expectedResults;
+        for (auto const& tx : txs)
+            expectedResults.push_back (serial (expected, tx));
+
+        OpenView actual (batch_view, *env.current());
+        std::vector<SpeculativeApply::Entry> entries;
+        for (auto const& tx : txs)
+            entries.push_back ({ tx, tapNONE });
+        SpeculativeApply speculative (app, actual,
+            std::move(entries), 3, env.journal);
+        for (std::size_t i = 0; i < txs.size(); ++i)
+        {
+            auto const result = speculative.apply (i, actual,
+                [&](OpenView& view)
+                {
+                    return serial (view, txs[i]);
+                });
+            BEAST_EXPECT(result == expectedResults[i]);
+        }
+
+        BEAST_EXPECT(expectedResults[0].second);
+        BEAST_EXPECT(expectedResults[2].second);
+        BEAST_EXPECT(! expectedResults[5].second);
+        BEAST_EXPECT(speculative.committed() >= 3);
+        BEAST_EXPECT(speculative.committed() < txs.size());
+        BEAST_EXPECT(actual.txCount() == expected.txCount());
+        BEAST_EXPECT(sameState (actual, expected));
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(SpeculativeApply,app,ripple);
+
+} // test
+} // ripple
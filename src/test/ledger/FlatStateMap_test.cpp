@@ -0,0 +1,309 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2017 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <test/jtx.h>
+#include <stoxum/ledger/ApplyViewImpl.h>
+#include <stoxum/ledger/OpenView.h>
+#include <stoxum/ledger/detail/FlatStateMap.h>
+#include <stoxum/basics/qalloc.h>
+#include <stoxum/beast/utility/rngfill.h>
+#include <stoxum/beast/xor_shift_engine.h>
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <random>
+
+namespace ripple {
+namespace test {
+
+class FlatStateMap_test : public beast::unit_test::suite
+{
+    using value = std::pair<int, std::shared_ptr<int>>;
+
+    template <std::size_t N, class Alloc = std::allocator<
+        std::pair<uint256 const, value>>>
+    using flat_map = detail::FlatStateMap<uint256, value, N, Alloc>;
+
+    using std_map = std::map<uint256, value>;
+
+    template <class Map>
+    bool
+    same (Map const& m, std_map const& s)
+    {
+        if (m.size() != s.size())
+            return false;
+        auto it = s.begin();
+        for (auto const& item : m)
+        {
+            if (item.first != it->first ||
+                    item.second.first != it->second.first ||
+                        *item.second.second != *it->second.second)
+                return false;
+            ++it;
+        }
+        return true;
+    }
+
+    template <class Map>
+    void
+    testRandom (char const* name)
+    {
+        testcase (name);
+
+        beast::xor_shift_engine g (std::uint64_t(std::strlen(name)));
+        std::uniform_int_distribution<std::uint64_t> keys (1, 40);
+        std::uniform_int_distribution<int> ops (0, 5);
+
+        Map m;
+        std_map s;
+        for (int i = 0; i < 2000; ++i)
+        {
+            uint256 const key (keys(g));
+            switch (ops(g))
+            {
+            case 0:
+            case 1:
+            {
+                auto const r1 = m.emplace (std::piecewise_construct,
+                    std::forward_as_tuple(key), std::forward_as_tuple(
+                        i, std::make_shared<int>(i)));
+                auto const r2 = s.emplace (std::piecewise_construct,
+                    std::forward_as_tuple(key), std::forward_as_tuple(
+                        i, std::make_shared<int>(i)));
+                BEAST_EXPECT(r1.second == r2.second);
+                BEAST_EXPECT(r1.first->first == key);
+                BEAST_EXPECT(r1.first->second.first ==
+                    r2.first->second.first);
+                break;
+            }
+            case 2:
+            {
+                auto iter = m.lower_bound (key);
+                if (iter == m.end() || iter->first != key)
+                {
+                    iter = m.emplace_hint (iter, std::piecewise_construct,
+                        std::forward_as_tuple(key), std::forward_as_tuple(
+                            i, std::make_shared<int>(i)));
+                    s.emplace (std::piecewise_construct,
+                        std::forward_as_tuple(key), std::forward_as_tuple(
+                            i, std::make_shared<int>(i)));
+                }
+                BEAST_EXPECT(iter->first == key);
+                break;
+            }
+            case 3:
+            {
+                auto const iter = m.find (key);
+                BEAST_EXPECT((iter == m.end()) == (s.count(key) == 0));
+                if (iter != m.end())
+                {
+                    m.erase (iter);
+                    s.erase (key);
+                }
+                break;
+            }
+            case 4:
+            {
+                auto const iter = m.upper_bound (key);
+                auto const match = s.upper_bound (key);
+                BEAST_EXPECT((iter == m.end()) == (match == s.end()));
+                if (iter != m.end() && match != s.end())
+                    BEAST_EXPECT(iter->first == match->first);
+                break;
+            }
+            default:
+            {
+                auto const iter = m.find (key);
+                if (iter != m.end())
+                    iter->second.first = -i;
+                auto const match = s.find (key);
+                if (match != s.end())
+                    match->second.first = -i;
+                break;
+            }
+            }
+            if (! BEAST_EXPECT(same(m, s)))
+                return;
+        }
+
+        Map const copy (m);
+        BEAST_EXPECT(same(copy, s));
+        Map const moved (std::move(m));
+        BEAST_EXPECT(same(moved, s));
+        BEAST_EXPECT(m.empty());
+    }
+
+    void
+    testOverflow ()
+    {
+        testcase ("overflow");
+
+        flat_map<4> m;
+        for (std::uint64_t i = 8; i > 0; --i)
+            m.emplace (uint256(i), value(int(i), std::make_shared<int>(0)));
+        BEAST_EXPECT(m.size() == 8);
+        std::uint64_t i = 1;
+        for (auto const& item : m)
+            BEAST_EXPECT(item.first == uint256(i++));
+        BEAST_EXPECT(m.find(uint256(5))->second.first == 5);
+        BEAST_EXPECT(m.find(uint256(9)) == m.end());
+    }
+
+public:
+    void
+    run() override
+    {
+        testRandom<flat_map<8>> ("small");
+        testRandom<flat_map<64>> ("flat");
+        testRandom<flat_map<8, qalloc_type<
+            std::pair<uint256 const, value>, false>>> ("qalloc");
+        testOverflow();
+    }
+};
+
+//------------------------------------------------------------------------------
+
+// Measures the cost of the per-transaction state tables.
+class FlatStateMap_manual_test : public beast::unit_test::suite
+{
+    using clock_type = std::chrono::steady_clock;
+
+    using value = std::pair<int, std::shared_ptr<SLE>>;
+
+    void
+    report (char const* name, clock_type::duration elapsed, int count)
+    {
+        using namespace std::chrono;
+        log << "    " << name << ": " <<
+            duration_cast<nanoseconds>(elapsed).count() / count <<
+                " ns per tx" << std::endl;
+    }
+
+    // Touch a handful of keys the way a simple payment does
+    template <class Map>
+    clock_type::duration
+    timeTable (std::vector<uint256> const& keys, int count)
+    {
+        auto const sle = std::make_shared<SLE>(
+            Keylet{ltACCOUNT_ROOT, uint256(1)});
+        auto const start = clock_type::now();
+        for (int i = 0; i < count; ++i)
+        {
+            Map m;
+            for (std::size_t j = 0; j < 6; ++j)
+            {
+                auto const& key = keys[(i + j * 7919) % keys.size()];
+                auto iter = m.lower_bound (key);
+                if (iter == m.end() || iter->first != key)
+                    m.emplace_hint (iter, std::piecewise_construct,
+                        std::forward_as_tuple(key),
+                            std::forward_as_tuple(0, sle));
+            }
+            for (auto& item : m)
+                m.find(item.first)->second.first = 1;
+        }
+        return clock_type::now() - start;
+    }
+
+    void
+    testTables (std::vector<uint256> const& keys)
+    {
+        testcase ("tables");
+
+        int const count = 200000;
+        report ("std::map", timeTable<
+            std::map<uint256, value>>(keys, count), count);
+        report ("std::map qalloc", timeTable<
+            std::map<uint256, value, std::less<uint256>,
+                qalloc_type<std::pair<uint256 const, value>, false>>>(
+                    keys, count), count);
+        report ("FlatStateMap", timeTable<
+            detail::FlatStateMap<uint256, value, 16>>(
+                keys, count), count);
+        pass();
+    }
+
+    void
+    testApplyView (std::vector<uint256> const& keys)
+    {
+        testcase ("ApplyViewImpl");
+
+        using namespace jtx;
+        Env env(*this);
+        Account const alice ("alice");
+        env.fund (STM(10000), alice);
+        env.close();
+        auto const jt = env.jt (noop(alice));
+
+        OpenView base (&*env.current());
+        for (auto const& key : keys)
+        {
+            auto const sle = std::make_shared<SLE>(
+                Keylet{ltACCOUNT_ROOT, key});
+            sle->setFieldU32 (sfSequence, 1);
+            base.rawInsert (sle);
+        }
+
+        int const count = 20000;
+        auto const start = clock_type::now();
+        for (int i = 0; i < count; ++i)
+        {
+            OpenView ov (&base);
+            ApplyViewImpl view (&ov, tapNONE);
+            for (std::size_t j = 0; j < 4; ++j)
+            {
+                auto const sle = view.peek (Keylet{ltACCOUNT_ROOT,
+                    keys[(i + j * 7919) % keys.size()]});
+                sle->setFieldU32 (sfSequence, i);
+                view.update (sle);
+            }
+            view.apply (ov, *jt.stx, tesSUCCESS, env.journal);
+        }
+        // Build with RIPPLE_FLAT_STATE_TABLES=0 for the std::map baseline
+        report (RIPPLE_FLAT_STATE_TABLES ?
+            "OpenView + ApplyViewImpl (FlatStateMap tables)" :
+                "OpenView + ApplyViewImpl (std::map tables)",
+            clock_type::now() - start, count);
+        pass();
+    }
+
+public:
+    void
+    run() override
+    {
+        beast::xor_shift_engine g (19207813);
+        std::vector<uint256> keys;
+        for (int i = 0; i < 1000; ++i)
+        {
+            std::uint8_t buf[32];
+            beast::rngfill (buf, sizeof(buf), g);
+            keys.push_back (uint256::fromVoid (buf));
+        }
+
+        testTables (keys);
+        testApplyView (keys);
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(FlatStateMap,ledger,ripple);
+BEAST_DEFINE_TESTSUITE_MANUAL(FlatStateMap_manual,ledger,ripple);
+
+} // test
+} // ripple
@@ -367,6 +367,75 @@ class PaymentSandbox_test : public beast::unit_test::suite
         BEAST_EXPECT (balance.getIssuer() == USD.issue().account);
     }
 
+    void testDeferredCredits()
+    {
+        // Credits recorded by a sandbox are added to its parent's, while
+        // the parent keeps the original balances it recorded first.
+        testcase ("deferredCredits");
+
+        using namespace jtx;
+        using ripple::detail::DeferredCredits;
+
+        Account const gw ("gw");
+        std::vector<Account> const accounts {
+            Account ("alice"), Account ("bob"), Account ("carol"),
+            Account ("dan"), Account ("erin") };
+        auto const USD = gw["USD"];
+        auto const EUR = gw["EUR"];
+
+        DeferredCredits parent;
+        DeferredCredits child;
+
+        // The parent records the lines of every other account
+        for (std::size_t i = 0; i < accounts.size (); i += 2)
+            parent.credit (gw, accounts[i], USD (10), USD (100));
+        parent.ownerCount (accounts[0], 3, 2);
+
+        // The child records every line, latest account first
+        for (std::size_t i = accounts.size (); i-- != 0;)
+        {
+            child.credit (gw, accounts[i], USD (5), USD (200));
+            child.credit (accounts[i], gw, EUR (1), EUR (50));
+        }
+        child.ownerCount (accounts[0], 4, 1);
+        child.ownerCount (accounts[1], 1, 2);
+
+        child.apply (parent);
+
+        for (std::size_t i = 0; i < accounts.size (); ++i)
+        {
+            bool const both = i % 2 == 0;
+
+            auto const usd = parent.adjustments (
+                accounts[i], gw, USD.currency);
+            if (! BEAST_EXPECT(usd))
+                continue;
+            BEAST_EXPECT(usd->credits == USD (both ? 15 : 5));
+            BEAST_EXPECT(usd->debits == USD (0));
+            BEAST_EXPECT(usd->origBalance == USD (both ? -100 : -200));
+
+            auto const eur = parent.adjustments (
+                accounts[i], gw, EUR.currency);
+            if (! BEAST_EXPECT(eur))
+                continue;
+            BEAST_EXPECT(eur->credits == EUR (0));
+            BEAST_EXPECT(eur->debits == EUR (1));
+            BEAST_EXPECT(eur->origBalance == EUR (50));
+        }
+
+        BEAST_EXPECT(! parent.adjustments (gw, gw, USD.currency));
+        BEAST_EXPECT(parent.ownerCount (accounts[0]) == 4u);
+        BEAST_EXPECT(parent.ownerCount (accounts[1]) == 2u);
+        BEAST_EXPECT(! parent.ownerCount (accounts[2]));
+
+        // Applying to an empty table copies it
+        DeferredCredits empty;
+        parent.apply (empty);
+        auto const usd = empty.adjustments (accounts[1], gw, USD.currency);
+        BEAST_EXPECT(usd && usd->credits == USD (5));
+        BEAST_EXPECT(empty.ownerCount (accounts[0]) == 4u);
+    }
+
 public:
     void run ()
     {
@@ -382,6 +451,7 @@ public:
         testAll(sa - featureFlow - fix1373 - featureFlowCross);
         testAll(sa                         - featureFlowCross);
         testAll(sa);
+        testDeferredCredits();
     }
 };
 
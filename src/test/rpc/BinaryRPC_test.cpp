@@ -0,0 +1,249 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2017 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+#include <BeastConfig.h>
+#include <stoxum/app/main/Application.h>
+#include <stoxum/app/misc/NetworkOPs.h>
+#include <stoxum/protocol/ErrorCodes.h>
+#include <stoxum/protocol/JsonFields.h>
+#include <stoxum/resource/Fees.h>
+#include <stoxum/rpc/BinaryRPC.h>
+#include <test/jtx.h>
+
+namespace ripple {
+namespace test {
+
+class BinaryRPC_test : public beast::unit_test::suite
+{
+    // Runs a command and checks the response header
+    Serializer
+    binary (jtx::Env& env, Json::Value params,
+        error_code_i expected = rpcSUCCESS)
+    {
+        auto& app = env.app();
+        Resource::Charge loadType = Resource::feeReferenceRPC;
+        Resource::Consumer c;
+        RPC::Context context {beast::Journal(), std::move (params), app,
+            loadType, app.getOPs(), app.getLedgerMaster(), c, Role::USER, {}};
+
+        Serializer s;
+        auto const status = RPC::doBinaryCommand (context, s);
+        BEAST_EXPECT(bool (status) == (expected != rpcSUCCESS));
+
+        SerialIter sit (s.slice());
+        BEAST_EXPECT(sit.get8() == RPC::binaryFormatVersion);
+        BEAST_EXPECT(sit.get32() == expected);
+        if (expected != rpcSUCCESS)
+        {
+            auto const token = sit.getVL();
+            BEAST_EXPECT(std::string (token.begin(), token.end()) ==
+                RPC::get_error_info (expected).token);
+            sit.getVL();
+            BEAST_EXPECT(sit.empty());
+        }
+        return s;
+    }
+
+    void
+    testLedgerData()
+    {
+        testcase ("ledger_data");
+
+        using namespace jtx;
+        Env env (*this);
+        for (int i = 0; i < 20; ++i)
+            env.fund (STM(1000), Account ("bob" + std::to_string (i)));
+        env.close();
+
+        Json::Value params;
+        params[jss::command] = "ledger_data";
+        params[jss::ledger_index] = "closed";
+        params[jss::limit] = 10;
+
+        auto const expected = env.rpc ("json", "ledger_data",
+            to_string (params))[jss::result];
+
+        auto const s = binary (env, params);
+        SerialIter sit (s.slice());
+        sit.skip (5);
+        BEAST_EXPECT(sit.get32() == env.closed()->info().seq);
+        BEAST_EXPECT(sit.get256() == env.closed()->info().hash);
+        auto const count = sit.get32();
+        BEAST_EXPECT(count == 10);
+        BEAST_EXPECT(count == expected[jss::state].size());
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            auto const key = sit.get256();
+            auto const& entry = expected[jss::state][i];
+            BEAST_EXPECT(to_string (key) == entry[jss::index].asString());
+            auto const data = sit.getVL();
+            auto const sle = env.closed()->read (keylet::unchecked (key));
+            if (! BEAST_EXPECT(sle))
+                continue;
+            Serializer ss;
+            sle->add (ss);
+            BEAST_EXPECT(data == ss.peekData());
+        }
+        BEAST_EXPECT(sit.get8() == 1);
+        BEAST_EXPECT(to_string (sit.get256()) ==
+            expected[jss::marker].asString());
+        BEAST_EXPECT(sit.empty());
+
+        params[jss::ledger_index] = 1000;
+        binary (env, params, rpcLGR_NOT_FOUND);
+    }
+
+    void
+    testAccountTx()
+    {
+        testcase ("account_tx");
+
+        using namespace jtx;
+        Env env (*this);
+        Account const alice ("alice");
+        Account const bob ("bob");
+        env.fund (STM(10000), alice, bob);
+        env.close();
+        for (int i = 0; i < 5; ++i)
+        {
+            env (pay (alice, bob, STM(1)));
+            env.close();
+        }
+
+        Json::Value params;
+        params[jss::command] = "account_tx";
+        params[jss::account] = alice.human();
+        params[jss::limit] = 4;
+
+        auto const expected = env.rpc ("json", "account_tx",
+            to_string (params))[jss::result];
+
+        auto const s = binary (env, params);
+        SerialIter sit (s.slice());
+        sit.skip (5);
+        BEAST_EXPECT(sit.get32() ==
+            expected[jss::ledger_index_min].asUInt());
+        BEAST_EXPECT(sit.get32() ==
+            expected[jss::ledger_index_max].asUInt());
+        auto const count = sit.get32();
+        BEAST_EXPECT(count == 4);
+        BEAST_EXPECT(count == expected[jss::transactions].size());
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            auto const& tx = expected[jss::transactions][i];
+            BEAST_EXPECT(sit.get32() ==
+                tx[jss::tx][jss::ledger_index].asUInt());
+            auto const raw = sit.getVL();
+            SerialIter txit (makeSlice (raw));
+            BEAST_EXPECT(to_string (STTx (txit).getTransactionID()) ==
+                tx[jss::tx][jss::hash].asString());
+            BEAST_EXPECT(! sit.getVL().empty());
+        }
+        BEAST_EXPECT(sit.get8() == 1);
+        BEAST_EXPECT(sit.get32() ==
+            expected[jss::marker][jss::ledger].asUInt());
+        BEAST_EXPECT(sit.get32() ==
+            expected[jss::marker][jss::seq].asUInt());
+        BEAST_EXPECT(sit.empty());
+
+        params[jss::account] = "not an account";
+        binary (env, params, rpcACT_MALFORMED);
+    }
+
+    void
+    testBookOffers()
+    {
+        testcase ("book_offers");
+
+        using namespace jtx;
+        Env env (*this);
+        Account const gw ("gateway");
+        Account const alice ("alice");
+        auto const USD = gw["USD"];
+        env.fund (STM(10000), gw, alice);
+        env.trust (USD(1000), alice);
+        env (pay (gw, alice, USD(100)));
+        for (int i = 1; i <= 3; ++i)
+            env (offer (alice, STM(10 * i), USD(10)));
+        env.close();
+
+        Json::Value params;
+        params[jss::command] = "book_offers";
+        params[jss::ledger_index] = "validated";
+        params[jss::taker_pays][jss::currency] = "STM";
+        params[jss::taker_gets][jss::currency] = "USD";
+        params[jss::taker_gets][jss::issuer] = gw.human();
+
+        auto const expected = env.rpc ("json", "book_offers",
+            to_string (params))[jss::result];
+
+        auto const s = binary (env, params);
+        SerialIter sit (s.slice());
+        sit.skip (5);
+        BEAST_EXPECT(sit.get32() == env.closed()->info().seq);
+        auto const count = sit.get32();
+        BEAST_EXPECT(count == 3);
+        BEAST_EXPECT(count == expected[jss::offers].size());
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            auto const raw = sit.getVL();
+            SerialIter offerit (makeSlice (raw));
+            STLedgerEntry const sle (offerit, uint256{});
+            BEAST_EXPECT(sle.getFieldAmount (sfTakerPays).getJson (0) ==
+                expected[jss::offers][i][jss::TakerPays]);
+        }
+        BEAST_EXPECT(sit.empty());
+
+        params[jss::taker_gets][jss::currency] = "STM";
+        params[jss::taker_gets].removeMember (jss::issuer);
+        binary (env, params, rpcBAD_MARKET);
+    }
+
+    void
+    testUnsupported()
+    {
+        testcase ("unsupported");
+
+        using namespace jtx;
+        Env env (*this);
+
+        Json::Value params;
+        params[jss::command] = "server_info";
+        binary (env, params, rpcUNKNOWN_COMMAND);
+
+        params[jss::command] = "no_such_command";
+        binary (env, params, rpcUNKNOWN_COMMAND);
+    }
+
+public:
+    void
+    run() override
+    {
+        testLedgerData();
+        testAccountTx();
+        testBookOffers();
+        testUnsupported();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(BinaryRPC,rpc,ripple);
+
+} // test
+} // ripple
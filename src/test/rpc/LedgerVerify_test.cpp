@@ -0,0 +1,106 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012-2016 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <stoxum/protocol/ErrorCodes.h>
+#include <stoxum/protocol/JsonFields.h>
+#include <stoxum/beast/unit_test.h>
+#include <test/jtx.h>
+
+namespace ripple {
+
+class LedgerVerify_test : public beast::unit_test::suite
+{
+public:
+    void
+    testBadInput()
+    {
+        using namespace test::jtx;
+        Env env (*this);
+
+        {
+            auto const result = env.rpc ("json", "ledger_verify",
+                "{ \"min_ledger\" : 2 }")[jss::result];
+            BEAST_EXPECT(result[jss::error_message] ==
+                "Missing field 'max_ledger'.");
+        }
+        {
+            auto const result = env.rpc (
+                "ledger_verify", "3", "2")[jss::result];
+            BEAST_EXPECT(result[jss::error_message] ==
+                "Invalid field 'max_ledger'.");
+        }
+        {
+            auto const result = env.rpc (
+                "ledger_verify", "0", "2")[jss::result];
+            BEAST_EXPECT(result[jss::error_message] ==
+                "Invalid field 'min_ledger'.");
+        }
+    }
+
+    void
+    testVerify()
+    {
+        using namespace test::jtx;
+        Env env (*this);
+
+        Account const alice ("alice");
+        Account const bob ("bob");
+        env.fund (STM(10000), alice, bob);
+        env.close();
+        for (int i = 0; i < 4; ++i)
+        {
+            env (pay (alice, bob, STM(10 + i)));
+            env (pay (bob, alice, STM(1)));
+            env.close();
+        }
+        auto const last = env.closed()->info().seq;
+
+        auto result = env.rpc ("ledger_verify", "3",
+            std::to_string (last))[jss::result];
+        BEAST_EXPECT(result[jss::status] == "success");
+        BEAST_EXPECT(result[jss::checked] == last - 2);
+        BEAST_EXPECT(result[jss::failures].size() == 0);
+        BEAST_EXPECT(result[jss::nodes].asUInt() > 0);
+
+        result = env.rpc ("ledger_verify", "3",
+            std::to_string (last), "replay")[jss::result];
+        BEAST_EXPECT(result[jss::replay].asBool());
+        BEAST_EXPECT(result[jss::checked] == last - 2);
+        BEAST_EXPECT(result[jss::failures].size() == 0);
+
+        // Ledgers that were never stored are reported
+        result = env.rpc ("ledger_verify", std::to_string (last),
+            std::to_string (last + 1))[jss::result];
+        BEAST_EXPECT(result[jss::checked] == 2);
+        BEAST_EXPECT(result[jss::failures].size() == 1 &&
+            result[jss::failures][0u][jss::ledger_index] == last + 1);
+    }
+
+    void
+    run() override
+    {
+        testBadInput();
+        testVerify();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(LedgerVerify,app,ripple);
+
+} // ripple
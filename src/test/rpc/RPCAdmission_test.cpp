@@ -0,0 +1,107 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2017 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+
+#include <BeastConfig.h>
+#include <stoxum/rpc/RPCAdmission.h>
+#include <stoxum/core/JobQueue.h>
+#include <stoxum/beast/unit_test.h>
+#include <stoxum/protocol/JsonFields.h>
+#include <test/jtx.h>
+
+namespace ripple {
+namespace test {
+
+class RPCAdmission_test : public beast::unit_test::suite
+{
+    void
+    testDecide()
+    {
+        testcase ("decide");
+
+        using namespace std::chrono;
+        RPCAdmission::Setup setup;
+        setup.targetWait = milliseconds (500);
+        setup.refuseAllFactor = 4;
+
+        auto const decide = [&](milliseconds wait, Role role, bool heavy)
+        {
+            return RPCAdmission::decide (setup, wait, role, heavy);
+        };
+
+        // Under the target everything is admitted
+        BEAST_EXPECT(! decide (milliseconds (400), Role::USER, true));
+        BEAST_EXPECT(! decide (milliseconds (400), Role::GUEST, false));
+
+        // Over the target heavy calls are refused first
+        auto retry = decide (milliseconds (600), Role::USER, true);
+        BEAST_EXPECT(retry && *retry == seconds (1));
+        BEAST_EXPECT(! decide (milliseconds (600), Role::USER, false));
+
+        // Far over the target every call is refused
+        retry = decide (milliseconds (2500), Role::GUEST, false);
+        BEAST_EXPECT(retry && *retry == seconds (3));
+        retry = decide (milliseconds (2500), Role::USER, true);
+        BEAST_EXPECT(retry && *retry == seconds (3));
+
+        // Unlimited clients are never refused
+        BEAST_EXPECT(! decide (milliseconds (9000), Role::ADMIN, true));
+        BEAST_EXPECT(! decide (milliseconds (9000), Role::IDENTIFIED, true));
+
+        // A zero target turns the check off
+        setup.targetWait = milliseconds (0);
+        BEAST_EXPECT(! decide (milliseconds (9000), Role::GUEST, true));
+    }
+
+    void
+    testIdle()
+    {
+        testcase ("idle");
+
+        using namespace jtx;
+        Env env (*this, envconfig([](std::unique_ptr<Config> cfg)
+            {
+                cfg->section ("rpc_admission").set ("target_wait_ms", "1");
+                return cfg;
+            }));
+
+        // Nothing waits in the queue, so calls are admitted
+        BEAST_EXPECT(env.app().getJobQueue().getQueueWait (
+            jtCLIENT).count() == 0);
+        BEAST_EXPECT(! env.app().getRPCAdmission().check (Role::GUEST, true));
+
+        auto const result = env.rpc ("server_info")[jss::result];
+        BEAST_EXPECT(result[jss::status] == "success");
+        BEAST_EXPECT(! result.isMember (jss::retry_after));
+    }
+
+public:
+    void
+    run() override
+    {
+        testDecide();
+        testIdle();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(RPCAdmission,rpc,ripple);
+
+} // test
+} // ripple
@@ -0,0 +1,101 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2017 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <stoxum/rpc/RPCResponseCache.h>
+#include <stoxum/beast/unit_test.h>
+#include <stoxum/protocol/JsonFields.h>
+#include <test/jtx.h>
+
+namespace ripple {
+namespace test {
+
+class RPCResponseCache_test : public beast::unit_test::suite
+{
+    static
+    Json::Value
+    accountInfo (jtx::Env& env, jtx::Account const& account,
+        Json::Value const& ledgerIndex)
+    {
+        Json::Value params;
+        params[jss::account] = account.human();
+        params[jss::ledger_index] = ledgerIndex;
+        return env.rpc ("json", "account_info",
+            to_string (params))[jss::result];
+    }
+
+public:
+    void
+    run() override
+    {
+        using namespace jtx;
+        Env env (*this);
+        auto& cache = env.app().getRPCResponseCache();
+
+        Account const alice ("alice");
+        Account const bob ("bob");
+        env.fund (STM(10000), alice);
+        env.close();
+
+        auto const seq = env.closed()->info().seq;
+        auto const first = accountInfo (env, alice, seq);
+        BEAST_EXPECT(first[jss::validated].asBool());
+        BEAST_EXPECT(cache.getCacheSize() == 1);
+
+        // The same request, or one for the same ledger by
+        // another name, is answered from the cache
+        BEAST_EXPECT(accountInfo (env, alice, seq) == first);
+        BEAST_EXPECT(accountInfo (env, alice, "validated") == first);
+        BEAST_EXPECT(cache.getCacheSize() == 1);
+        BEAST_EXPECT(cache.getHitRate() > 0);
+
+        // The current ledger can change
+        accountInfo (env, alice, "current");
+        BEAST_EXPECT(cache.getCacheSize() == 1);
+
+        // Errors are not kept
+        BEAST_EXPECT(accountInfo (env, bob, seq).isMember (jss::error));
+        BEAST_EXPECT(cache.getCacheSize() == 1);
+
+        env (pay (alice, env.master, STM(1000)));
+        auto const txID = to_string (env.tx()->getTransactionID());
+        env.close();
+
+        // The old ledger still answers the same, the validated
+        // ledger is a different one now
+        BEAST_EXPECT(accountInfo (env, alice, seq) == first);
+        auto const second = accountInfo (env, alice, "validated");
+        BEAST_EXPECT(second[jss::ledger_index].asUInt() == seq + 1);
+        BEAST_EXPECT(second[jss::account_data][sfBalance.fieldName] !=
+            first[jss::account_data][sfBalance.fieldName]);
+        BEAST_EXPECT(cache.getCacheSize() == 2);
+
+        // Validated transactions are kept
+        auto const tx = env.rpc ("tx", txID)[jss::result];
+        BEAST_EXPECT(tx[jss::validated].asBool());
+        BEAST_EXPECT(cache.getCacheSize() == 3);
+        BEAST_EXPECT(env.rpc ("tx", txID)[jss::result] == tx);
+        BEAST_EXPECT(cache.getCacheSize() == 3);
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(RPCResponseCache,rpc,ripple);
+
+} // test
+} // ripple
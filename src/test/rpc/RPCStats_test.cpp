@@ -0,0 +1,116 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2017 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <BeastConfig.h>
+#include <stoxum/rpc/RPCStats.h>
+#include <stoxum/beast/insight/NullCollector.h>
+#include <stoxum/beast/unit_test.h>
+#include <stoxum/protocol/JsonFields.h>
+#include <test/jtx.h>
+
+namespace ripple {
+namespace test {
+
+class RPCStats_test : public beast::unit_test::suite
+{
+    beast::Journal journal;
+
+    void
+    testPercentiles()
+    {
+        testcase ("percentiles");
+
+        using namespace std::chrono;
+        RPCStats stats ({}, beast::insight::NullCollector::New(), journal);
+
+        // 90 fast calls and 10 slow ones
+        for (int i = 0; i < 90; ++i)
+            stats.onCall ("fast", {}, microseconds (100), false);
+        for (int i = 0; i < 10; ++i)
+            stats.onCall ("fast", {}, microseconds (5000), i == 0);
+        stats.onTraffic ("fast", 10, 200);
+        stats.onTraffic ("unknown", 10, 200);
+
+        auto const json = stats.getJson();
+        BEAST_EXPECT(json.size() == 1);
+        auto const& fast = json["fast"];
+        BEAST_EXPECT(fast["calls"].asUInt() == 100);
+        BEAST_EXPECT(fast["failures"].asUInt() == 1);
+        BEAST_EXPECT(fast["mean_us"].asUInt() == 590);
+        // Percentiles are the upper bound of their bucket
+        BEAST_EXPECT(fast["p50_us"].asUInt() == 128);
+        BEAST_EXPECT(fast["p90_us"].asUInt() == 128);
+        BEAST_EXPECT(fast["p99_us"].asUInt() == 5000);
+        BEAST_EXPECT(fast["max_us"].asUInt() == 5000);
+        BEAST_EXPECT(fast["request_bytes"] == "10");
+        BEAST_EXPECT(fast["response_bytes"] == "200");
+    }
+
+    void
+    testRedact()
+    {
+        testcase ("redact");
+
+        Json::Value params;
+        params[jss::command] = "sign";
+        params[jss::secret] = "snoPBrXtMeMyMHUVTgbuqAfg1SUTb";
+        params[jss::tx_json][jss::Account] = "alice";
+        params[jss::tx_json]["password"] = "hunter2";
+
+        auto const redacted = RPCStats::redact (params);
+        BEAST_EXPECT(redacted[jss::command] == "sign");
+        BEAST_EXPECT(redacted[jss::secret] == "<redacted>");
+        BEAST_EXPECT(redacted[jss::tx_json][jss::Account] == "alice");
+        BEAST_EXPECT(redacted[jss::tx_json]["password"] == "<redacted>");
+    }
+
+    void
+    testGetCounts()
+    {
+        testcase ("get_counts");
+
+        using namespace jtx;
+        Env env (*this);
+
+        env.rpc ("server_info");
+        env.rpc ("server_info");
+        env.rpc ("account_info", "not_an_account");
+
+        auto const result = env.rpc ("get_counts")[jss::result];
+        BEAST_EXPECT(result.isMember (jss::rpc_methods));
+        auto const& methods = result[jss::rpc_methods];
+        BEAST_EXPECT(methods["server_info"]["calls"].asUInt() == 2);
+        BEAST_EXPECT(methods["server_info"]["failures"].asUInt() == 0);
+        BEAST_EXPECT(methods["account_info"]["failures"].asUInt() == 1);
+    }
+
+public:
+    void
+    run() override
+    {
+        testPercentiles();
+        testRedact();
+        testGetCounts();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(RPCStats,rpc,ripple);
+
+} // test
+} // ripple
@@ -0,0 +1,118 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2017 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+#include <BeastConfig.h>
+#include <stoxum/app/main/Application.h>
+#include <stoxum/app/misc/NetworkOPs.h>
+#include <stoxum/json/json_reader.h>
+#include <stoxum/json/Object.h>
+#include <stoxum/protocol/JsonFields.h>
+#include <stoxum/resource/Fees.h>
+#include <stoxum/rpc/RPCHandler.h>
+#include <test/jtx.h>
+
+namespace ripple {
+namespace test {
+
+class StreamingRPC_test : public beast::unit_test::suite
+{
+    // Runs a command both ways and checks that the results match
+    void
+    check (jtx::Env& env, Json::Value const& params, bool streams = true)
+    {
+        auto& app = env.app();
+        Resource::Charge loadType = Resource::feeReferenceRPC;
+        Resource::Consumer c;
+        RPC::Context context {beast::Journal(), params, app,
+            loadType, app.getOPs(), app.getLedgerMaster(), c, Role::ADMIN, {}};
+
+        BEAST_EXPECT(RPC::streamsResult (
+            params[jss::command].asString()) == streams);
+
+        Json::Value expected;
+        auto const expectedStatus = RPC::doCommand (context, expected);
+
+        std::string text;
+        RPC::Status status;
+        {
+            auto object = Json::stringWriterObject (text);
+            status = RPC::doCommand (context, *object);
+        }
+        BEAST_EXPECT(bool (status) == bool (expectedStatus));
+
+        Json::Value written;
+        BEAST_EXPECT(Json::Reader().parse (text, written));
+        BEAST_EXPECT(written == expected);
+    }
+
+public:
+    void
+    run() override
+    {
+        using namespace jtx;
+        Env env (*this);
+        Account const alice ("alice");
+        Account const bob ("bob");
+        env.fund (STM(10000), alice, bob);
+        env.close();
+        for (int i = 0; i < 5; ++i)
+        {
+            env (pay (alice, bob, STM(1)));
+            env.close();
+        }
+
+        Json::Value params;
+        params[jss::command] = "ledger_data";
+        params[jss::ledger_index] = "closed";
+        check (env, params);
+        params[jss::binary] = true;
+        params[jss::limit] = 3;
+        check (env, params);
+        params[jss::marker] = "bad";
+        check (env, params);
+
+        params = Json::objectValue;
+        params[jss::command] = "account_tx";
+        params[jss::account] = alice.human();
+        check (env, params);
+        params[jss::binary] = true;
+        params[jss::limit] = 2;
+        check (env, params);
+        params[jss::account] = "bad";
+        check (env, params);
+
+        params = Json::objectValue;
+        params[jss::command] = "ledger";
+        params[jss::ledger_index] = "closed";
+        params[jss::full] = true;
+        check (env, params);
+        params[jss::ledger_index] = 1000;
+        check (env, params);
+
+        params = Json::objectValue;
+        params[jss::command] = "ledger_closed";
+        check (env, params, false);
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(StreamingRPC,rpc,ripple);
+
+} // test
+} // ripple
@@ -990,6 +990,92 @@ class ServerStatus_test :
         }
     }
 
+    void
+    testPipelining(boost::asio::yield_context& yield)
+    {
+        testcase ("Pipelined and batch requests");
+
+        using namespace test::jtx;
+        using namespace boost::asio;
+        using namespace beast::http;
+        Env env {*this};
+
+        auto const port = env.app().config()["port_rpc"].
+            get<std::uint16_t>("port").value();
+        auto const ip = env.app().config()["port_rpc"].
+            get<std::string>("ip").value();
+
+        boost::system::error_code ec;
+        io_service& ios = get_io_service();
+        ip::tcp::resolver r{ios};
+        auto it =
+            r.async_resolve(
+                ip::tcp::resolver::query{ip, to_string(port)}, yield[ec]);
+        BEAST_EXPECT(! ec);
+
+        ip::tcp::socket sock{ios};
+        async_connect(sock, it, yield[ec]);
+        BEAST_EXPECT(! ec);
+
+        // Send every request before reading any response
+        char const* const methods[] =
+            { "ledger_closed", "ping", "server_info", "ping", "fee" };
+        int id = 0;
+        for (auto const method : methods)
+        {
+            Json::Value jr;
+            jr[jss::method] = method;
+            jr[jss::params] = Json::arrayValue;
+            jr[jss::params][0u] = Json::objectValue;
+            jr[jss::params][0u][jss::id] = id++;
+            auto req = makeHTTPRequest(ip, port, to_string(jr), {});
+            async_write(sock, req, yield[ec]);
+            BEAST_EXPECT(! ec);
+        }
+
+        // The responses come back in order
+        beast::multi_buffer sb;
+        for (int i = 0; i < id; ++i)
+        {
+            response<string_body> resp;
+            async_read(sock, sb, resp, yield[ec]);
+            BEAST_EXPECT(! ec);
+            BEAST_EXPECT(resp.result() == status::ok);
+            Json::Value jv;
+            BEAST_EXPECT(Json::Reader{}.parse(resp.body, jv));
+            BEAST_EXPECT(jv[jss::result][jss::status] == "success");
+            BEAST_EXPECT(jv[jss::id] == i);
+        }
+
+        // A batch runs its calls at once, and replies in order
+        Json::Value jb;
+        jb[jss::method] = "batch";
+        jb[jss::params] = Json::arrayValue;
+        for (int i = 0; i < 20; ++i)
+        {
+            Json::Value call;
+            call[jss::method] = methods[i % id];
+            call[jss::id] = i;
+            jb[jss::params].append(call);
+        }
+        {
+            auto req = makeHTTPRequest(ip, port, to_string(jb), {});
+            async_write(sock, req, yield[ec]);
+            BEAST_EXPECT(! ec);
+            response<string_body> resp;
+            async_read(sock, sb, resp, yield[ec]);
+            BEAST_EXPECT(! ec);
+            Json::Value jv;
+            BEAST_EXPECT(Json::Reader{}.parse(resp.body, jv));
+            BEAST_EXPECT(jv.isArray() && jv.size() == 20);
+            for (Json::UInt i = 0; i < jv.size(); ++i)
+            {
+                BEAST_EXPECT(jv[i][jss::id] == i);
+                BEAST_EXPECT(jv[i][jss::result][jss::status] == "success");
+            }
+        }
+    }
+
     void
     testStatusNotOkay(boost::asio::yield_context& yield)
     {
@@ -1047,6 +1133,7 @@ public:
             testNoRPC (yield);
             testWSRequests (yield);
             testRPCRequests (yield);
+            testPipelining (yield);
             testStatusNotOkay (yield);
         });
 
@@ -22,6 +22,7 @@
 #include <stoxum/beast/rfc2616.h>
 #include <stoxum/server/Server.h>
 #include <stoxum/server/Session.h>
+#include <stoxum/server/WSSession.h>
 #include <stoxum/beast/unit_test.h>
 #include <stoxum/core/ConfigSections.h>
 #include <test/jtx.h>
@@ -538,12 +539,43 @@ public:
             != std::string::npos);
     }
 
+    void
+    testSharedWSMsg()
+    {
+        testcase ("shared websocket message");
+
+        auto const data = std::make_shared<std::string const> (
+            "{\"type\":\"ledgerClosed\"}\n");
+
+        // Drain a message a few bytes at a time
+        auto const drain = [&](SharedWSMsg& m, std::size_t bytes)
+        {
+            std::string out;
+            for (;;)
+            {
+                auto const result = m.prepare (bytes, nullptr);
+                for (auto const& b : result.second)
+                    out.append (boost::asio::buffer_cast<char const*>(b),
+                        boost::asio::buffer_size (b));
+                if (result.first)
+                    return out;
+            }
+        };
+
+        SharedWSMsg m1 (data);
+        SharedWSMsg m2 (data);
+        BEAST_EXPECT (drain (m1, 5) == *data);
+        BEAST_EXPECT (drain (m2, 65536) == *data);
+        BEAST_EXPECT (*data == "{\"type\":\"ledgerClosed\"}\n");
+    }
+
     void
     run()
     {
         basicTests();
         stressTest();
         testBadConfig();
+        testSharedWSMsg();
     }
 };
 
@@ -0,0 +1,124 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of rippled: https://github.com/ripple/rippled
+    Copyright (c) 2012, 2017 Ripple Labs Inc.
+
+    Permission to use, copy, modify, and/or distribute this software for any
+    purpose  with  or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL ,  DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+
+#include <BeastConfig.h>
+#include <stoxum/server/impl/WSQueue.h>
+#include <stoxum/beast/unit_test.h>
+#include <string>
+
+namespace ripple {
+namespace test {
+
+class WSQueue_test : public beast::unit_test::suite
+{
+    static
+    std::shared_ptr<WSMsg>
+    msg(std::string const& text, std::string kind = {})
+    {
+        return std::make_shared<SharedWSMsg>(
+            std::make_shared<std::string const>(text), std::move(kind));
+    }
+
+    // The text of the front message
+    static
+    std::string
+    text(WSQueue& q)
+    {
+        auto const b = q.front().prepare(65536, []{}).second;
+        std::string s;
+        for (auto const& buf : b)
+            s.append(boost::asio::buffer_cast<char const*>(buf),
+                boost::asio::buffer_size(buf));
+        return s;
+    }
+
+    void
+    testLimits()
+    {
+        testcase ("limits");
+
+        // Three messages after the one being written
+        WSQueue q (3, 1000);
+        for (int i = 0; i < 4; ++i)
+            BEAST_EXPECT(q.push(msg("tx" + std::to_string(i))));
+        BEAST_EXPECT(! q.push(msg("tx4")));
+        BEAST_EXPECT(q.size() == 4);
+        BEAST_EXPECT(q.bytes() == 12);
+
+        q.drop_pending();
+        BEAST_EXPECT(q.size() == 1);
+        BEAST_EXPECT(text(q) == "tx0");
+        q.pop();
+        BEAST_EXPECT(q.empty());
+        BEAST_EXPECT(q.bytes() == 0);
+        BEAST_EXPECT(q.stats().sent == 1);
+        BEAST_EXPECT(q.stats().sentBytes == 3);
+        BEAST_EXPECT(q.stats().peakBytes == 12);
+
+        // Bytes limit, but one message always fits
+        WSQueue b (100, 10);
+        BEAST_EXPECT(b.push(msg(std::string(20, 'a'))));
+        BEAST_EXPECT(! b.push(msg("b")));
+        b.pop();
+        BEAST_EXPECT(b.push(msg("0123456789")));
+        BEAST_EXPECT(! b.push(msg("b")));
+    }
+
+    void
+    testCoalesce()
+    {
+        testcase ("coalesce");
+
+        WSQueue q (10, 1000);
+        BEAST_EXPECT(q.push(msg("server1", "serverStatus")));
+        BEAST_EXPECT(q.push(msg("tx1")));
+        BEAST_EXPECT(q.push(msg("ledger1", "ledgerClosed")));
+        BEAST_EXPECT(q.push(msg("tx2")));
+        // The front is being written, so it stays
+        BEAST_EXPECT(q.push(msg("server2", "serverStatus")));
+        BEAST_EXPECT(q.push(msg("ledger2", "ledgerClosed")));
+        BEAST_EXPECT(q.push(msg("server3", "serverStatus")));
+        BEAST_EXPECT(q.stats().coalesced == 2);
+
+        std::vector<std::string> sent;
+        while (! q.empty())
+        {
+            sent.push_back(text(q));
+            q.pop();
+        }
+        BEAST_EXPECT((sent == std::vector<std::string>{
+            "server1", "tx1", "tx2", "ledger2", "server3"}));
+        BEAST_EXPECT(q.bytes() == 0);
+    }
+
+public:
+    void
+    run() override
+    {
+        testLimits();
+        testCoalesce();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(WSQueue,server,ripple);
+
+} // test
+} // ripple
@@ -18,23 +18,29 @@
 */
 //==============================================================================
 
+#include <test/app/AccountTxIndex_test.cpp>
 #include <test/app/AccountTxPaging_test.cpp>
 #include <test/app/AmendmentTable_test.cpp>
+#include <test/app/BookIndex_test.cpp>
 #include <test/app/Check_test.cpp>
 #include <test/app/CrossingLimits_test.cpp>
 #include <test/app/DeliverMin_test.cpp>
 #include <test/app/DepositAuth_test.cpp>
 #include <test/app/Discrepancy_test.cpp>
 #include <test/app/Escrow_test.cpp>
+#include <test/app/FetchPack_test.cpp>
+#include <test/app/FlowBench_test.cpp>
 #include <test/app/Flow_test.cpp>
 #include <test/app/Freeze_test.cpp>
 #include <test/app/HashRouter_test.cpp>
 #include <test/app/LedgerLoad_test.cpp>
+#include <test/app/LedgerSaveQueue_test.cpp>
 #include <test/app/LoadFeeTrack_test.cpp>
 #include <test/app/Manifest_test.cpp>
 #include <test/app/MultiSign_test.cpp>
 #include <test/app/OfferStream_test.cpp>
 #include <test/app/Offer_test.cpp>
+#include <test/app/OrderBookDB_test.cpp>
 #include <test/app/OversizeMeta_test.cpp>
 
 #include <test/unit_test/multi_runner.cpp>
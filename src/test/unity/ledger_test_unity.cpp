@@ -21,6 +21,7 @@
 #include <test/ledger/BookDirs_test.cpp>
 #include <test/ledger/CashDiff_test.cpp>
 #include <test/ledger/Directory_test.cpp>
+#include <test/ledger/FlatStateMap_test.cpp>
 #include <test/ledger/Invariants_test.cpp>
 #include <test/ledger/PaymentSandbox_test.cpp>
 #include <test/ledger/PendingSaves_test.cpp>
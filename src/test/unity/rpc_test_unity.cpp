@@ -26,6 +26,7 @@
 #include <test/rpc/AccountSet_test.cpp>
 #include <test/rpc/AccountTx_test.cpp>
 #include <test/rpc/AmendmentBlocked_test.cpp>
+#include <test/rpc/BinaryRPC_test.cpp>
 #include <test/rpc/Book_test.cpp>
 #include <test/rpc/Feature_test.cpp>
 #include <test/rpc/GatewayBalances_test.cpp>
@@ -36,14 +37,19 @@
 #include <test/rpc/LedgerData_test.cpp>
 #include <test/rpc/LedgerRPC_test.cpp>
 #include <test/rpc/LedgerRequestRPC_test.cpp>
+#include <test/rpc/LedgerVerify_test.cpp>
 #include <test/rpc/NoRipple_test.cpp>
 #include <test/rpc/NoRippleCheck_test.cpp>
 #include <test/rpc/OwnerInfo_test.cpp>
 #include <test/rpc/Peers_test.cpp>
 #include <test/rpc/RobustTransaction_test.cpp>
+#include <test/rpc/RPCAdmission_test.cpp>
 #include <test/rpc/RPCOverload_test.cpp>
+#include <test/rpc/RPCResponseCache_test.cpp>
+#include <test/rpc/RPCStats_test.cpp>
 #include <test/rpc/ServerInfo_test.cpp>
 #include <test/rpc/Status_test.cpp>
+#include <test/rpc/StreamingRPC_test.cpp>
 #include <test/rpc/Subscribe_test.cpp>
 #include <test/rpc/TransactionEntry_test.cpp>
 #include <test/rpc/TransactionHistory_test.cpp>